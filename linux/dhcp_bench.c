@@ -0,0 +1,266 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * dhcp_bench
+ *
+ * Runs wifi_setup/dhcp_server.c on the host (lwip_sim.c) and measures
+ * the time to process a DISCOVER and a REQUEST: "clients" clients get an
+ * address, again and again for "rounds" rounds. Every reply is checked.
+ * Cycles are counted with the time stamp counter on x86, elsewhere the
+ * nanoseconds are shown instead. The debug output of the server goes to
+ * /dev/null while the clients are served: it is still formatted, as on
+ * the Pico-W, but the terminal does not slow down the measurement.
+ *
+ * -f delivers each request in pbufs of "chunk" bytes instead of one.
+ * -e lets all leases expire after each round, the clients then get an
+ * address from the free list again instead of renewing their lease.
+ * -r asks for Rapid Commit: the DISCOVER is answered by an ACK.
+ *
+ * Usage: dhcp_bench [-c clients] [-n rounds] [-f chunk] [-e] [-r]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define cycles() __rdtsc()
+#define CYCLE_UNIT "cycles"
+#else
+#define cycles() now_ns()
+#define CYCLE_UNIT "ns"
+#endif
+
+#include "lwip_sim.h"
+#include "dhcp_server.h"
+
+#define DHCPDISCOVER    1
+#define DHCPOFFER       2
+#define DHCPREQUEST     3
+#define DHCPACK         5
+
+#define BOOTP_SIZE      300     // most clients pad to this size
+#define OPTIONS_OFFSET  240     // after the magic cookie
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// Builds a request of client "n", returns its length
+static size_t build_request(uint8_t *msg, int n, uint8_t type, const uint8_t *requested_ip,
+                            const uint8_t *server_id, bool rapid_commit)
+{
+    uint8_t *o;
+
+    memset(msg, 0, BOOTP_SIZE);
+    msg[0] = 1;                 // BOOTREQUEST
+    msg[1] = 1;                 // Ethernet
+    msg[2] = 6;
+    msg[4] = n;                 // xid
+    msg[5] = 0x5a;
+    msg[28] = 0x02;             // chaddr, locally administered
+    msg[29] = 0x42;
+    msg[32] = n >> 8;
+    msg[33] = n;
+    msg[236] = 99;              // magic cookie
+    msg[237] = 130;
+    msg[238] = 83;
+    msg[239] = 99;
+
+    o = msg + OPTIONS_OFFSET;
+    *o++ = 53; *o++ = 1; *o++ = type;
+    *o++ = 61; *o++ = 7; *o++ = 1; memcpy(o, msg + 28, 6); o += 6;
+    if(requested_ip){
+        *o++ = 50; *o++ = 4; memcpy(o, requested_ip, 4); o += 4;
+    }
+    if(server_id){
+        *o++ = 54; *o++ = 4; memcpy(o, server_id, 4); o += 4;
+    }
+    if(rapid_commit){
+        *o++ = 80; *o++ = 0;
+    }
+    *o++ = 55; *o++ = 4; *o++ = 1; *o++ = 3; *o++ = 6; *o++ = 15;
+    *o++ = 12; *o++ = 6; memcpy(o, "sensor", 6); o += 6;
+    *o++ = 255;
+    return BOOTP_SIZE;
+}
+
+// Returns the message type of the last reply, 0 if there was none
+static int reply_type(uint32_t count_before)
+{
+    if(lwip_sim_sent_count == count_before || lwip_sim_sent_len < OPTIONS_OFFSET + 3)
+        return 0;
+    for(size_t i = OPTIONS_OFFSET; i + 2 < lwip_sim_sent_len && lwip_sim_sent[i] != 255;){
+        if(lwip_sim_sent[i] == 0){
+            i++;
+            continue;
+        }
+        if(lwip_sim_sent[i] == 53)
+            return lwip_sim_sent[i + 2];
+        i += 2 + lwip_sim_sent[i + 1];
+    }
+    return 0;
+}
+
+typedef struct _timing {
+    uint64_t *samples;
+    uint64_t total;
+    uint32_t count;
+} timing;
+
+static void record(timing *t, uint64_t c)
+{
+    t->samples[t->count++] = c;
+    t->total += c;
+}
+
+static int compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+    return x < y ? -1 : x > y;
+}
+
+// Processes one request, returns the type of the reply
+static int process(const uint8_t *msg, size_t len, size_t chunk, timing *t)
+{
+    struct pbuf *p = lwip_sim_packet(msg, len, chunk);
+    uint32_t count = lwip_sim_sent_count;
+
+    uint64_t c = cycles();
+    lwip_sim_input(p);
+    record(t, cycles() - c);
+    return reply_type(count);
+}
+
+static void print_timing(const char *name, timing *t)
+{
+    if(!t->count)
+        return;
+    qsort(t->samples, t->count, sizeof(t->samples[0]), compare);
+    printf("%-10s %9u %10.0f %10llu %10llu %10llu %10llu\n", name, t->count,
+           (double)t->total / t->count,
+           (unsigned long long)t->samples[0],
+           (unsigned long long)t->samples[t->count / 2],
+           (unsigned long long)t->samples[t->count * 99 / 100],
+           (unsigned long long)t->samples[t->count - 1]);
+}
+
+int main(int argc, char *argv[])
+{
+    int clients = DHCPS_MAX_IP, rounds = 10000, opt;
+    size_t chunk = 0;
+    bool expire = false, rapid_commit = false;
+    size_t reply_len = 0;
+    uint8_t msg[BOOTP_SIZE];
+    timing discover = { 0 }, request = { 0 };
+    int failures = 0;
+    static int owner[256], owner_round[256];   // client + 1 and round, by address
+
+    while((opt = getopt(argc, argv, "c:n:f:er")) != -1){
+        switch(opt){
+            case 'c': clients = atoi(optarg); break;
+            case 'n': rounds = atoi(optarg); break;
+            case 'f': chunk = atoi(optarg); break;
+            case 'e': expire = true; break;
+            case 'r': rapid_commit = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-c clients] [-n rounds] [-f chunk] [-e] [-r]\n", argv[0]);
+                return 1;
+        }
+    }
+    if(clients < 1 || clients > 0xffff || rounds < 1){
+        fprintf(stderr, "invalid arguments\n");
+        return 1;
+    }
+
+    discover.samples = malloc(sizeof(uint64_t) * clients * rounds);
+    request.samples = malloc(sizeof(uint64_t) * clients * rounds);
+    if(!discover.samples || !request.samples){
+        fprintf(stderr, "out of memory\n");
+        free(discover.samples);
+        free(request.samples);
+        return 1;
+    }
+
+    static dhcp_server_t server;
+    ip_addr_t ip, mask;
+    IP4_ADDR(&ip,   192, 168,   0, 1);
+    IP4_ADDR(&mask, 255, 255, 255, 0);
+    dhcp_server_init(&server, &ip, &mask);
+    uint8_t server_id[4] = { 192, 168, 0, 1 };
+
+    fflush(stdout);
+    int out = dup(STDOUT_FILENO);
+    int null = open("/dev/null", O_WRONLY);
+    if(out < 0 || null < 0 || dup2(null, STDOUT_FILENO) < 0){
+        perror("/dev/null");
+        return 1;
+    }
+    close(null);
+
+    for(int r = 0; r < rounds; r++){
+        for(int n = 0; n < clients; n++){
+            size_t len = build_request(msg, n, DHCPDISCOVER, NULL, NULL, rapid_commit);
+            if(process(msg, len, chunk, &discover) != (rapid_commit ? DHCPACK : DHCPOFFER)){
+                failures++;
+                continue;
+            }
+            uint8_t yiaddr[4];
+            memcpy(yiaddr, lwip_sim_sent + 16, 4);
+            if(!rapid_commit){
+                len = build_request(msg, n, DHCPREQUEST, yiaddr, server_id, false);
+                if(process(msg, len, chunk, &request) != DHCPACK){
+                    failures++;
+                    continue;
+                }
+            }
+            reply_len = lwip_sim_sent_len;
+            // no address is given to two clients
+            if(owner[yiaddr[3]] && owner[yiaddr[3]] != n + 1 && owner_round[yiaddr[3]] == r){
+                fprintf(stderr, "round %d: %u.%u.%u.%u given to clients %d and %d\n", r,
+                        yiaddr[0], yiaddr[1], yiaddr[2], yiaddr[3], owner[yiaddr[3]] - 1, n);
+                failures++;
+            }
+            owner[yiaddr[3]] = n + 1;
+            owner_round[yiaddr[3]] = r;
+        }
+        // one day and a few minutes: the leases expire
+        lwip_sim_ms += expire ? 24 * 3600 * 1000 + 300000 : 1000;
+    }
+    dhcp_server_deinit(&server);
+    fflush(stdout);
+    dup2(out, STDOUT_FILENO);
+    close(out);
+
+    printf("%d clients, %d rounds, pool of %d addresses%s%s%s\n", clients, rounds, DHCPS_MAX_IP,
+           chunk ? ", fragmented pbufs" : "", expire ? ", leases expire" : "",
+           rapid_commit ? ", rapid commit" : "");
+    printf("%-10s %9s %10s %10s %10s %10s %10s   (%s)\n", "request", "count", "average",
+           "min", "median", "99%", "max", CYCLE_UNIT);
+    print_timing("DISCOVER", &discover);
+    print_timing("REQUEST", &request);
+    printf("ACK: %zu bytes\n", reply_len);
+    if(failures)
+        printf("%d requests without the expected reply\n", failures);
+    free(discover.samples);
+    free(request.samples);
+    return 0;
+}
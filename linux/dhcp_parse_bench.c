@@ -0,0 +1,370 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * dhcp_parse_bench
+ *
+ * Checks wifi_setup/dhcp_options.c against a corpus of malformed option
+ * fields and random mutations of valid requests, then measures the time
+ * to parse the options of a DISCOVER and a REQUEST.
+ *
+ * Every case is passed to dhcp_options_parse() and, inside a request, to
+ * the DHCP server (lwip_sim.c). Each buffer is allocated with the exact
+ * length of the data, build with "make dhcp_parse_bench SANITIZE=1" to
+ * have AddressSanitizer catch any read past the end. A malformed request
+ * must not be answered.
+ *
+ * The time of the parser is compared with the lookups used before: the
+ * message type at a fixed place and a scan from the start for every
+ * other option. Cycles are counted with the time stamp counter on x86,
+ * elsewhere the nanoseconds are shown instead.
+ *
+ * Usage: dhcp_parse_bench [-m mutations] [-n iterations] [-s seed]
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define cycles() __rdtsc()
+#define CYCLE_UNIT "cycles"
+#else
+#define cycles() now_ns()
+#define CYCLE_UNIT "ns"
+#endif
+
+#include "lwip_sim.h"
+#include "dhcp_server.h"
+#include "dhcp_options.h"
+
+#define BOOTP_HEADER    236     // up to the options field
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*
+ * Corpus: options fields (magic cookie and options) and the expected result
+ */
+typedef struct _corpus_case {
+    const char *name;
+    const uint8_t *options;
+    size_t len;
+    dhcp_options_status expect;
+    uint8_t type;               // message type if DHCP_OPTIONS_OK
+} corpus_case;
+
+#define COOKIE 99, 130, 83, 99
+#define CASE(name, expect, type, ...) \
+    { name, (const uint8_t[]){ __VA_ARGS__ }, sizeof((const uint8_t[]){ __VA_ARGS__ }), expect, type }
+
+static const corpus_case corpus[] = {
+    CASE("discover",                DHCP_OPTIONS_OK, 1,         COOKIE, 53, 1, 1, 255),
+    CASE("type not first",          DHCP_OPTIONS_OK, 3,         COOKIE, 12, 3, 'p', 'i', 'c', 53, 1, 3, 255),
+    CASE("type last, no end",       DHCP_OPTIONS_OK, 1,         COOKIE, 55, 2, 1, 3, 53, 1, 1),
+    CASE("pad options",             DHCP_OPTIONS_OK, 1,         COOKIE, 0, 0, 53, 1, 1, 0, 255),
+    CASE("data after end",          DHCP_OPTIONS_OK, 1,         COOKIE, 53, 1, 1, 255, 53, 1, 3, 7),
+    CASE("repeated type",           DHCP_OPTIONS_OK, 1,         COOKIE, 53, 1, 1, 53, 1, 3, 255),
+    CASE("empty request list",      DHCP_OPTIONS_OK, 1,         COOKIE, 53, 1, 1, 55, 0, 255),
+    CASE("list up to the last byte", DHCP_OPTIONS_OK, 1,        COOKIE, 53, 1, 1, 55, 3, 1, 3, 6),
+    CASE("zero length option last", DHCP_OPTIONS_OK, 1,         COOKIE, 53, 1, 1, 80, 0),
+    CASE("no cookie",               DHCP_OPTIONS_NO_COOKIE, 0,  53, 1, 1, 255),
+    CASE("wrong cookie",            DHCP_OPTIONS_NO_COOKIE, 0,  99, 130, 83, 98, 53, 1, 1, 255),
+    CASE("short cookie",            DHCP_OPTIONS_NO_COOKIE, 0,  99, 130, 83),
+    CASE("only cookie",             DHCP_OPTIONS_NO_TYPE, 0,    COOKIE),
+    CASE("only end",                DHCP_OPTIONS_NO_TYPE, 0,    COOKIE, 255),
+    CASE("only pads",               DHCP_OPTIONS_NO_TYPE, 0,    COOKIE, 0, 0, 0, 0),
+    CASE("type after end",          DHCP_OPTIONS_NO_TYPE, 0,    COOKIE, 255, 53, 1, 1),
+    CASE("type 0",                  DHCP_OPTIONS_NO_TYPE, 0,    COOKIE, 53, 1, 0, 255),
+    CASE("code without length",     DHCP_OPTIONS_TRUNCATED, 0,  COOKIE, 53, 1, 1, 12),
+    CASE("type without value",      DHCP_OPTIONS_TRUNCATED, 0,  COOKIE, 53, 1),
+    CASE("length past the end",     DHCP_OPTIONS_TRUNCATED, 0,  COOKIE, 53, 1, 1, 12, 10, 'p'),
+    CASE("length 255",              DHCP_OPTIONS_TRUNCATED, 0,  COOKIE, 53, 1, 1, 55, 255, 1, 3),
+    CASE("list one byte short",     DHCP_OPTIONS_TRUNCATED, 0,  COOKIE, 53, 1, 1, 55, 4, 1, 3, 6),
+    CASE("type length 0",           DHCP_OPTIONS_BAD_LENGTH, 0, COOKIE, 53, 0, 255),
+    CASE("type length 2",           DHCP_OPTIONS_BAD_LENGTH, 0, COOKIE, 53, 2, 1, 1, 255),
+    CASE("requested ip length 3",   DHCP_OPTIONS_BAD_LENGTH, 0, COOKIE, 53, 1, 3, 50, 3, 192, 168, 0, 255),
+    CASE("server id length 5",      DHCP_OPTIONS_BAD_LENGTH, 0, COOKIE, 53, 1, 3, 54, 5, 192, 168, 0, 1, 0, 255),
+    CASE("rapid commit length 1",   DHCP_OPTIONS_BAD_LENGTH, 0, COOKIE, 53, 1, 1, 80, 1, 0, 255),
+};
+
+#define CORPUS_CASES (sizeof(corpus) / sizeof(corpus[0]))
+
+// Typical requests: the options of a DISCOVER and of a REQUEST
+static const uint8_t discover_options[] = {
+    COOKIE, 53, 1, 1, 61, 7, 1, 2, 66, 0, 0, 0, 1, 57, 2, 5, 220,
+    12, 6, 's', 'e', 'n', 's', 'o', 'r', 55, 6, 1, 3, 6, 15, 26, 28, 255
+};
+static const uint8_t request_options[] = {
+    COOKIE, 53, 1, 3, 61, 7, 1, 2, 66, 0, 0, 0, 1, 50, 4, 192, 168, 0, 16,
+    54, 4, 192, 168, 0, 1, 57, 2, 5, 220, 12, 6, 's', 'e', 'n', 's', 'o', 'r',
+    55, 6, 1, 3, 6, 15, 26, 28, 255
+};
+
+static dhcp_server_t server;
+static int errors;
+static int stdout_fd, null_fd;     // the debug output of the server goes to /dev/null
+
+// Passes a request with "options" to the server, returns true if it answered
+static bool serve(const uint8_t *options, size_t len)
+{
+    uint8_t *msg = calloc(1, BOOTP_HEADER + len);
+    uint32_t count = lwip_sim_sent_count;
+
+    if(!msg)
+        abort();
+    msg[0] = 1;                 // BOOTREQUEST
+    msg[1] = 1;
+    msg[2] = 6;
+    msg[28] = 0x02;             // chaddr
+    msg[33] = rand();
+    memcpy(msg + BOOTP_HEADER, options, len);
+    fflush(stdout);
+    dup2(null_fd, STDOUT_FILENO);
+    lwip_sim_input(lwip_sim_packet(msg, BOOTP_HEADER + len, 0));
+    fflush(stdout);
+    dup2(stdout_fd, STDOUT_FILENO);
+    free(msg);
+    return lwip_sim_sent_count != count;
+}
+
+// Checks that everything "o" points to lies in the "len" bytes at "options"
+static bool in_bounds(const uint8_t *options, size_t len, const dhcp_options *o)
+{
+    const uint8_t *end = options + len;
+
+    if(o->requested_ip && (o->requested_ip < options || o->requested_ip + 4 > end))
+        return false;
+    if(o->server_id && (o->server_id < options || o->server_id + 4 > end))
+        return false;
+    if(o->param_request_list &&
+       (o->param_request_list < options || o->param_request_list + o->param_request_len > end))
+        return false;
+    return true;
+}
+
+// Parses a copy of exactly "len" bytes, so reads past the end are caught
+static dhcp_options_status parse_copy(const uint8_t *options, size_t len, dhcp_options *o, bool *bounds)
+{
+    uint8_t *copy = malloc(len ? len : 1);
+    dhcp_options_status status;
+
+    if(!copy)
+        abort();
+    memcpy(copy, options, len);
+    status = dhcp_options_parse(copy, len, o);
+    *bounds = in_bounds(copy, len, o);
+    free(copy);
+    return status;
+}
+
+static void run_corpus()
+{
+    printf("%-26s %-12s %-12s %s\n", "case", "expected", "result", "answered");
+    for(size_t i = 0; i < CORPUS_CASES; i++){
+        const corpus_case *c = &corpus[i];
+        dhcp_options o;
+        bool bounds;
+        dhcp_options_status status = parse_copy(c->options, c->len, &o, &bounds);
+        bool answered = serve(c->options, c->len);
+        bool ok = status == c->expect && bounds &&
+                  (status != DHCP_OPTIONS_OK || o.type == c->type) &&
+                  (status == DHCP_OPTIONS_OK || !answered);
+
+        printf("%-26s %-12s %-12s %s%s\n", c->name, dhcp_options_status_name(c->expect),
+               dhcp_options_status_name(status), answered ? "yes" : "no", ok ? "" : "   FAILED");
+        if(!ok)
+            errors++;
+    }
+}
+
+// Random changes of a valid request: bytes overwritten, inserted, cut off
+static void run_mutations(int mutations)
+{
+    uint8_t buf[sizeof(request_options) + 16];
+    uint32_t results[DHCP_OPTIONS_NO_TYPE + 1] = { 0 };
+
+    for(int m = 0; m < mutations; m++){
+        const uint8_t *base = m & 1 ? request_options : discover_options;
+        size_t len = m & 1 ? sizeof(request_options) : sizeof(discover_options);
+
+        memcpy(buf, base, len);
+        for(int k = rand() % 4 + 1; k > 0 && len > 0; k--){
+            size_t at = rand() % len;
+            switch(rand() % 4){
+                case 0:     // any byte
+                    buf[at] = rand();
+                    break;
+                case 1:     // a length byte
+                    buf[at] = rand() % 2 ? 255 : rand() % 8;
+                    break;
+                case 2:     // insert a byte
+                    if(len < sizeof(buf)){
+                        memmove(buf + at + 1, buf + at, len - at);
+                        buf[at] = rand();
+                        len++;
+                    }
+                    break;
+                case 3:     // cut off
+                    len = at;
+                    break;
+            }
+        }
+
+        dhcp_options o;
+        bool bounds;
+        dhcp_options_status status = parse_copy(buf, len, &o, &bounds);
+        bool answered = serve(buf, len);
+        results[status]++;
+        if(!bounds || (status != DHCP_OPTIONS_OK && answered) ||
+           (status == DHCP_OPTIONS_OK && !o.type)){
+            printf("mutation %d: %s, %s\n", m, dhcp_options_status_name(status),
+                   bounds ? "answered" : "out of bounds");
+            errors++;
+        }
+    }
+    printf("\n%d mutations:", mutations);
+    for(int s = 0; s <= DHCP_OPTIONS_NO_TYPE; s++)
+        printf(" %s %u%s", dhcp_options_status_name(s), results[s], s < DHCP_OPTIONS_NO_TYPE ? "," : "\n");
+}
+
+/*
+ * The lookups before the single pass parser: the message type is taken
+ * from the third byte, every other option is searched from the start.
+ */
+static __attribute__((noinline)) const uint8_t *rescan_find(const uint8_t *opt, size_t len, uint8_t cmd)
+{
+    for(size_t i = 0; i < len && opt[i] != DHCP_OPTION_END;){
+        if(opt[i] == DHCP_OPTION_PAD){
+            i++;
+            continue;
+        }
+        if(i + 2 > len || i + 2 + opt[i + 1] > len)
+            break;
+        if(opt[i] == cmd)
+            return &opt[i];
+        i += 2 + opt[i + 1];
+    }
+    return NULL;
+}
+
+static volatile uintptr_t sink;
+
+// Lookups of the server for a DISCOVER (rapid commit, request list) or a REQUEST
+static void rescan(const uint8_t *options, size_t len)
+{
+    const uint8_t *opt = options + DHCP_MAGIC_COOKIE_LEN;
+    size_t n = len - DHCP_MAGIC_COOKIE_LEN;
+    uintptr_t r = opt[2];
+
+    if(opt[2] == 1){
+        r += (uintptr_t)rescan_find(opt, n, DHCP_OPTION_RAPID_COMMIT);
+    }
+    else{
+        r += (uintptr_t)rescan_find(opt, n, DHCP_OPTION_SERVER_ID);
+        r += (uintptr_t)rescan_find(opt, n, DHCP_OPTION_REQUESTED_IP);
+    }
+    r += (uintptr_t)rescan_find(opt, n, DHCP_OPTION_PARAM_REQUEST_LIST);
+    sink = r;
+}
+
+static void parse(const uint8_t *options, size_t len)
+{
+    dhcp_options o;
+
+    sink = dhcp_options_parse(options, len, &o) + (uintptr_t)o.param_request_list;
+}
+
+static int compare(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return x < y ? -1 : x > y;
+}
+
+// Median time of a call of "f", measured in batches of 100 calls
+static double measure(void (*f)(const uint8_t *, size_t), const uint8_t *options, size_t len,
+                      int iterations)
+{
+    enum { BATCH = 100 };
+    int batches = iterations / BATCH > 0 ? iterations / BATCH : 1;
+    double *t = malloc(sizeof(double) * batches);
+
+    if(!t)
+        abort();
+    for(int b = 0; b < batches; b++){
+        uint64_t c = cycles();
+        for(int i = 0; i < BATCH; i++)
+            f(options, len);
+        t[b] = (double)(cycles() - c) / BATCH;
+    }
+    qsort(t, batches, sizeof(double), compare);
+    double median = t[batches / 2];
+    free(t);
+    return median;
+}
+
+int main(int argc, char *argv[])
+{
+    int mutations = 100000, iterations = 1000000, opt;
+    unsigned seed = 1;
+
+    while((opt = getopt(argc, argv, "m:n:s:")) != -1){
+        switch(opt){
+            case 'm': mutations = atoi(optarg); break;
+            case 'n': iterations = atoi(optarg); break;
+            case 's': seed = strtoul(optarg, NULL, 0); break;
+            default:
+                fprintf(stderr, "usage: %s [-m mutations] [-n iterations] [-s seed]\n", argv[0]);
+                return 1;
+        }
+    }
+    srand(seed);
+
+    ip_addr_t ip, mask;
+    IP4_ADDR(&ip,   192, 168,   0, 1);
+    IP4_ADDR(&mask, 255, 255, 255, 0);
+    dhcp_server_init(&server, &ip, &mask);
+
+    stdout_fd = dup(STDOUT_FILENO);
+    null_fd = open("/dev/null", O_WRONLY);
+    if(stdout_fd < 0 || null_fd < 0){
+        perror("/dev/null");
+        return 1;
+    }
+    run_corpus();
+    run_mutations(mutations);
+    dhcp_server_deinit(&server);
+
+    printf("\n%-10s %12s %12s   (%s per request, median)\n", "options", "rescan", "single pass",
+           CYCLE_UNIT);
+    printf("%-10s %12.1f %12.1f\n", "DISCOVER",
+           measure(rescan, discover_options, sizeof(discover_options), iterations),
+           measure(parse, discover_options, sizeof(discover_options), iterations));
+    printf("%-10s %12.1f %12.1f\n", "REQUEST",
+           measure(rescan, request_options, sizeof(request_options), iterations),
+           measure(parse, request_options, sizeof(request_options), iterations));
+
+    if(errors){
+        printf("\n%d errors\n", errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,288 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * flash_bench
+ *
+ * Runs wifi_setup/flash_program.c on the host against a simulated NOR
+ * flash (nor_sim.c) and replays typical configuration updates.
+ * For each workload it reports per update: erases, programmed bytes,
+ * time with interrupts disabled (average and longest window) and the
+ * total time, as given by the timing model.
+ *
+ * -t prints the trace (trace.c) of the flash operations after each workload.
+ *
+ * Usage: flash_bench [-n updates] [-e erase_us] [-p program_us] [-c call_us] [-t]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "nor_sim.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "access_point.h"
+#include "config_store.h"
+#include "trace.h"
+
+#define COUNTER_KEY "counter"
+#define BURST 5     // changes per form submission
+
+static int updates = 1000;
+static bool show_trace;
+
+static void make_config(config *c, int n)
+{
+    memset(c, 0, sizeof(*c));
+    c->magic = MAGIC;
+    snprintf(c->ssid, sizeof(c->ssid), "network-%d", n);
+    snprintf(c->passwd, sizeof(c->passwd), "secret-%d", n);
+    c->ip.addr = c->mask.addr = c->gw.addr = IPADDR_NONE;
+}
+
+/*
+ * The flash code before the record log, as a reference:
+ * every write erased the last sector and programmed it completely,
+ * with interrupts disabled throughout.
+ */
+#define LEGACY_OFFSET (NOR_SIM_SIZE - FLASH_SECTOR_SIZE)
+#define LEGACY_CONFIG_PAGE 0
+
+static void legacy_write_page(const uint8_t *data, uint16_t buf_len, size_t pageStart)
+{
+    static uint8_t sector[FLASH_SECTOR_SIZE];
+    static uint8_t buf[FLASH_SECTOR_SIZE];
+    size_t numPages = (buf_len / FLASH_PAGE_SIZE) + (buf_len % FLASH_PAGE_SIZE ? 1 : 0);
+
+    memset(buf, 0xFF, FLASH_PAGE_SIZE * numPages);
+    memcpy(buf, data, buf_len);
+
+    // flash_erase_page()
+    memcpy(sector, nor_sim_flash + LEGACY_OFFSET, FLASH_SECTOR_SIZE);
+    uint32_t interrupts = save_and_disable_interrupts();
+    flash_range_erase(LEGACY_OFFSET, FLASH_SECTOR_SIZE);
+    memset(sector + pageStart * FLASH_PAGE_SIZE, 0xFF, numPages * FLASH_PAGE_SIZE);
+    flash_range_program(LEGACY_OFFSET, sector, FLASH_SECTOR_SIZE);
+    restore_interrupts(interrupts);
+
+    interrupts = save_and_disable_interrupts();
+    flash_range_program(LEGACY_OFFSET + FLASH_PAGE_SIZE * pageStart,
+                        buf, FLASH_PAGE_SIZE * numPages);
+    restore_interrupts(interrupts);
+}
+
+/*
+ * Workloads
+ * Each one is called "updates" times with the number of the update.
+ */
+static void wl_legacy(int n)
+{
+    config c;
+    make_config(&c, n);
+    legacy_write_page((uint8_t *)&c, sizeof(c), LEGACY_CONFIG_PAGE);
+}
+
+// The same configuration is saved again
+static void wl_rewrite(int n)
+{
+    config c;
+    make_config(&c, 0);
+    kv_put(WIFI_CONFIG_KEY, &c, sizeof(c));
+}
+
+// A new configuration, the device is idle between updates
+static void wl_update(int n)
+{
+    config c;
+    make_config(&c, n);
+    kv_put(WIFI_CONFIG_KEY, &c, sizeof(c));
+    flash_prepare_standby();
+}
+
+// A new configuration, flash_prepare_standby() is never called
+static void wl_update_busy(int n)
+{
+    config c;
+    make_config(&c, n);
+    kv_put(WIFI_CONFIG_KEY, &c, sizeof(c));
+}
+
+// "erase!" followed by a new setup
+static void wl_reprovision(int n)
+{
+    config c;
+    make_config(&c, n);
+    kv_delete(WIFI_CONFIG_KEY);
+    kv_put(WIFI_CONFIG_KEY, &c, sizeof(c));
+    flash_prepare_standby();
+}
+
+// A 4 byte counter under its own key, the configuration stays
+static void wl_counter(int n)
+{
+    uint32_t counter = n;
+    if(n == 0){
+        config c;
+        make_config(&c, 0);
+        kv_put(WIFI_CONFIG_KEY, &c, sizeof(c));
+    }
+    kv_put(COUNTER_KEY, &counter, sizeof(counter));
+    flash_prepare_standby();
+}
+
+// A form submission followed by a few changes, each one written at once
+static void wl_burst(int n)
+{
+    config c;
+    make_config(&c, n);
+    for(int i = 0; i < BURST; i++){
+        c.ip.addr = i;
+        kv_put(WIFI_CONFIG_KEY, &c, sizeof(c));
+    }
+    flash_prepare_standby();
+}
+
+// The same with config_set(), committed once when it is quiet
+static void wl_burst_deferred(int n)
+{
+    config c;
+    make_config(&c, n);
+    for(int i = 0; i < BURST; i++){
+        c.ip.addr = i;
+        config_set(&c);
+    }
+    config_flush();     // the quiet period is over
+    flash_prepare_standby();
+}
+
+typedef struct _workload {
+    const char *name;
+    void (*update)(int n);
+    bool uses_log;
+} workload;
+
+static const workload workloads[] = {
+    { "old method",   wl_legacy,      false },
+    { "rewrite",      wl_rewrite,     true  },
+    { "update",       wl_update,      true  },
+    { "update busy",  wl_update_busy, true  },
+    { "reprovision",  wl_reprovision, true  },
+    { "counter",      wl_counter,     true  },
+    { "burst",        wl_burst,       true  },
+    { "burst defer",  wl_burst_deferred, true },
+};
+
+/*
+ * Every workload runs in its own process, so it starts
+ * with an erased flash and a fresh flash_program.c
+ */
+static void run(const workload *w)
+{
+    nor_sim_reset();
+    if(w->uses_log)
+        flash_init();
+    trace_reset();
+
+    nor_sim_stats start = nor_sim_stat;
+    uint64_t t0 = nor_sim_time_us();
+    for(int n = 0; n < updates; n++)
+        w->update(n);
+    uint64_t t = nor_sim_time_us() - t0;
+
+    uint32_t erases = nor_sim_stat.erases - start.erases;
+    uint32_t bytes = (nor_sim_stat.pages_programmed - start.pages_programmed) * FLASH_PAGE_SIZE;
+    uint64_t irq_off = nor_sim_stat.irq_off_us - start.irq_off_us;
+    uint32_t max_wear = 0;
+    for(int s = 0; s < NOR_SIM_SECTORS; s++){
+        if(nor_sim_stat.erase_count[s] > max_wear)
+            max_wear = nor_sim_stat.erase_count[s];
+    }
+
+    // The erase counters in the sector headers must match the simulator
+    bool counts_ok = true;
+    if(w->uses_log){
+        uint32_t counts[FLASH_SECTORS];
+        flash_erase_counts(counts, FLASH_SECTORS);
+        for(int s = 0; s < FLASH_SECTORS; s++){
+            if(counts[s] != nor_sim_stat.erase_count[NOR_SIM_SECTORS - FLASH_SECTORS + s])
+                counts_ok = false;
+        }
+    }
+
+    printf("%-12s %9.3f %9.1f %10.1f %9lu %10.1f %9lu %s%s\n",
+           w->name,
+           (double)erases / updates,
+           (double)bytes / updates,
+           (double)irq_off / updates,
+           (unsigned long)nor_sim_stat.irq_off_max_us,
+           (double)t / updates,
+           (unsigned long)max_wear,
+           nor_sim_stat.bit_set_violations ? "BIT SET VIOLATIONS! " : "",
+           counts_ok ? "" : "ERASE COUNTS WRONG!");
+
+    // Workloads using config_set(): the flash writes saved
+    config_store_stats cs;
+    config_get_stats(&cs);
+    if(cs.updates){
+        printf("%-12s ", "");
+        config_show_stats();
+    }
+    if(show_trace && w->uses_log)
+        trace_print();
+    exit(nor_sim_stat.bit_set_violations || !counts_ok ? 1 : 0);
+}
+
+int main(int argc, char *argv[])
+{
+    int opt;
+    int status = 0;
+
+    while((opt = getopt(argc, argv, "n:e:p:c:t")) != -1){
+        switch(opt){
+            case 'n': updates = atoi(optarg); break;
+            case 'e': nor_sim_time_model.erase_us = atoi(optarg); break;
+            case 'p': nor_sim_time_model.program_us = atoi(optarg); break;
+            case 'c': nor_sim_time_model.call_us = atoi(optarg); break;
+            case 't': show_trace = true; break;
+            default:
+                fprintf(stderr, "usage: %s [-n updates] [-e erase_us] [-p program_us] [-c call_us] [-t]\n", argv[0]);
+                return 1;
+        }
+    }
+    if(updates <= 0)
+        updates = 1;
+
+    printf("%d updates, config %d bytes, %d sectors, erase %lu us, page program %lu us, call %lu us\n\n",
+           updates, (int)sizeof(config), FLASH_SECTORS,
+           (unsigned long)nor_sim_time_model.erase_us,
+           (unsigned long)nor_sim_time_model.program_us,
+           (unsigned long)nor_sim_time_model.call_us);
+    printf("%-12s %9s %9s %10s %9s %10s %9s\n", "", "erases", "bytes", "irq off", "max irq",
+           "time", "max wear");
+    printf("%-12s %9s %9s %10s %9s %10s %9s\n", "workload", "/update", "/update", "us/update", "off us",
+           "us/update", "erases");
+
+    for(size_t i = 0; i < sizeof(workloads) / sizeof(workloads[0]); i++){
+        fflush(stdout);
+        pid_t pid = fork();
+        if(pid == 0)
+            run(&workloads[i]);
+        int rc;
+        waitpid(pid, &rc, 0);
+        if(!WIFEXITED(rc) || WEXITSTATUS(rc))
+            status = 1;
+    }
+    return status;
+}
@@ -0,0 +1,171 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Minimal lwIP pbufs and UDP for the host build of wifi_setup/dhcp_server.c
+ *
+ * There is a single UDP pcb. lwip_sim_input() passes a datagram to its
+ * receive callback, as lwIP does, the last datagram sent is kept in
+ * lwip_sim_sent.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lwip_sim.h"
+
+struct udp_pcb {
+    udp_recv_fn recv;
+    void       *arg;
+};
+
+static struct udp_pcb pcb;
+static bool pcb_used;
+uint32_t lwip_sim_ms;
+uint8_t  lwip_sim_sent[LWIP_SIM_MTU];
+size_t   lwip_sim_sent_len;
+ip_addr_t lwip_sim_sent_to;
+uint32_t lwip_sim_sent_count;
+
+uint32_t cyw43_hal_ticks_ms(void)
+{
+    return lwip_sim_ms;
+}
+
+struct pbuf *pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type)
+{
+    struct pbuf *p = malloc(sizeof(struct pbuf) + length);
+
+    if(!p)
+        return NULL;
+    p->next = NULL;
+    p->payload = p + 1;
+    p->tot_len = p->len = length;
+    return p;
+}
+
+u8_t pbuf_free(struct pbuf *p)
+{
+    u8_t n = 0;
+
+    while(p){
+        struct pbuf *next = p->next;
+        free(p);
+        p = next;
+        n++;
+    }
+    return n;
+}
+
+// Only shrinks a single pbuf, as the DHCP server does
+void pbuf_realloc(struct pbuf *p, u16_t size)
+{
+    if(size < p->len)
+        p->tot_len = p->len = size;
+}
+
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len, u16_t offset)
+{
+    u16_t copied = 0;
+
+    for(; p && len; p = p->next){
+        if(offset >= p->len){
+            offset -= p->len;
+            continue;
+        }
+        u16_t n = p->len - offset < len ? p->len - offset : len;
+        memcpy((uint8_t *)dataptr + copied, (uint8_t *)p->payload + offset, n);
+        copied += n;
+        len -= n;
+        offset = 0;
+    }
+    return copied;
+}
+
+struct pbuf *pbuf_clone(pbuf_layer layer, pbuf_type type, struct pbuf *p)
+{
+    struct pbuf *q = pbuf_alloc(layer, p->tot_len, type);
+
+    if(q)
+        pbuf_copy_partial(p, q->payload, p->tot_len, 0);
+    return q;
+}
+
+struct udp_pcb *udp_new(void)
+{
+    if(pcb_used)
+        return NULL;
+    pcb_used = true;
+    memset(&pcb, 0, sizeof(pcb));
+    return &pcb;
+}
+
+void udp_recv(struct udp_pcb *pcb, udp_recv_fn recv, void *recv_arg)
+{
+    pcb->recv = recv;
+    pcb->arg = recv_arg;
+}
+
+err_t udp_bind(struct udp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port)
+{
+    return ERR_OK;
+}
+
+err_t udp_sendto(struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *dst_ip, u16_t dst_port)
+{
+    lwip_sim_sent_len = pbuf_copy_partial(p, lwip_sim_sent, sizeof(lwip_sim_sent), 0);
+    lwip_sim_sent_to = *dst_ip;
+    lwip_sim_sent_count++;
+    return ERR_OK;
+}
+
+void udp_remove(struct udp_pcb *pcb)
+{
+    pcb_used = false;
+}
+
+/*
+ * lwip_sim_packet()
+ *
+ * Returns "len" bytes of "data" in a chain of pbufs of "chunk" bytes
+ * (0: a single pbuf), as received by the driver.
+ */
+struct pbuf *lwip_sim_packet(const void *data, size_t len, size_t chunk)
+{
+    struct pbuf *head = NULL, **tail = &head;
+    size_t off = 0, rest = len;
+
+    if(!chunk)
+        chunk = len;
+    while(off < len){
+        size_t n = len - off < chunk ? len - off : chunk;
+        struct pbuf *q = pbuf_alloc(PBUF_TRANSPORT, n, PBUF_RAM);
+        if(!q)
+            abort();
+        memcpy(q->payload, (const uint8_t *)data + off, n);
+        q->tot_len = rest;
+        rest -= n;
+        *tail = q;
+        tail = &q->next;
+        off += n;
+    }
+    return head;
+}
+
+// Passes "p" to the receive callback, which frees it
+void lwip_sim_input(struct pbuf *p)
+{
+    if(pcb.recv)
+        pcb.recv(pcb.arg, &pcb, p, NULL, 68);
+    else
+        pbuf_free(p);
+}
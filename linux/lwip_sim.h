@@ -0,0 +1,33 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef LWIP_SIM_H
+#define LWIP_SIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lwip/udp.h"
+
+#define LWIP_SIM_MTU 1500
+
+extern uint32_t lwip_sim_ms;                    // returned by cyw43_hal_ticks_ms()
+extern uint8_t  lwip_sim_sent[LWIP_SIM_MTU];    // the last datagram sent
+extern size_t   lwip_sim_sent_len;
+extern ip_addr_t lwip_sim_sent_to;
+extern uint32_t lwip_sim_sent_count;
+
+struct pbuf *lwip_sim_packet(const void *data, size_t len, size_t chunk);
+void lwip_sim_input(struct pbuf *p);
+
+#endif // LWIP_SIM_H
@@ -0,0 +1,130 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nor_sim.h"
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "pico/cyw43_arch.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+uint8_t nor_sim_flash[NOR_SIM_SIZE] __attribute__((aligned(NOR_SIM_SECTOR_SIZE)));
+
+// Typical values of the W25Q16JV on the Pico-W
+nor_sim_timing nor_sim_time_model = {
+    .erase_us   = 45000,
+    .program_us = 400,
+    .call_us    = 20,
+};
+
+nor_sim_stats nor_sim_stat;
+
+static uint64_t now_us;
+static int irq_depth;
+static uint64_t irq_off_since;
+
+void nor_sim_reset()
+{
+    memset(nor_sim_flash, 0xFF, sizeof(nor_sim_flash));
+    memset(&nor_sim_stat, 0, sizeof(nor_sim_stat));
+    now_us = 0;
+    irq_depth = 0;
+}
+
+uint64_t nor_sim_time_us()
+{
+    return now_us;
+}
+
+/*
+ * pico-sdk replacements
+ */
+void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+    if(flash_offs % NOR_SIM_SECTOR_SIZE || count % NOR_SIM_SECTOR_SIZE ||
+       flash_offs + count > NOR_SIM_SIZE){
+        fprintf(stderr, "flash_range_erase(0x%lx, %lu): bad range\n",
+                (unsigned long)flash_offs, (unsigned long)count);
+        abort();
+    }
+    now_us += nor_sim_time_model.call_us;
+    for(size_t s = flash_offs / NOR_SIM_SECTOR_SIZE; count; s++, count -= NOR_SIM_SECTOR_SIZE){
+        memset(nor_sim_flash + s * NOR_SIM_SECTOR_SIZE, 0xFF, NOR_SIM_SECTOR_SIZE);
+        nor_sim_stat.erases++;
+        nor_sim_stat.erase_count[s]++;
+        now_us += nor_sim_time_model.erase_us;
+    }
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count)
+{
+    if(flash_offs % NOR_SIM_PAGE_SIZE || count % NOR_SIM_PAGE_SIZE ||
+       flash_offs + count > NOR_SIM_SIZE){
+        fprintf(stderr, "flash_range_program(0x%lx, %lu): bad range\n",
+                (unsigned long)flash_offs, (unsigned long)count);
+        abort();
+    }
+    now_us += nor_sim_time_model.call_us;
+    for(size_t i = 0; i < count; i++){
+        uint8_t *cell = nor_sim_flash + flash_offs + i;
+        if(data[i] & ~*cell)
+            nor_sim_stat.bit_set_violations++;
+        *cell &= data[i];
+        if(i % NOR_SIM_PAGE_SIZE == 0){
+            nor_sim_stat.pages_programmed++;
+            now_us += nor_sim_time_model.program_us;
+        }
+    }
+}
+
+uint32_t save_and_disable_interrupts()
+{
+    if(irq_depth++ == 0)
+        irq_off_since = now_us;
+    return 0;
+}
+
+void restore_interrupts(uint32_t status)
+{
+    if(--irq_depth)
+        return;
+    uint32_t window = now_us - irq_off_since;
+    nor_sim_stat.irq_off_us += window;
+    nor_sim_stat.irq_off_windows++;
+    if(window > nor_sim_stat.irq_off_max_us)
+        nor_sim_stat.irq_off_max_us = window;
+}
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms)
+{
+    uint32_t interrupts = save_and_disable_interrupts();
+    func(param);
+    restore_interrupts(interrupts);
+    return PICO_OK;
+}
+
+// There is no cyw43 async context, flash_commit_async() is not available
+async_context_t *cyw43_arch_async_context()
+{
+    return NULL;
+}
+
+void async_context_acquire_lock_blocking(async_context_t *context) {}
+void async_context_release_lock(async_context_t *context) {}
+bool async_context_add_when_pending_worker(async_context_t *context, async_when_pending_worker_t *worker) { return false; }
+void async_context_set_work_pending(async_context_t *context, async_when_pending_worker_t *worker) {}
+bool async_context_add_at_time_worker_in_ms(async_context_t *context, async_at_time_worker_t *worker, uint32_t ms) { return false; }
+bool async_context_remove_at_time_worker(async_context_t *context, async_at_time_worker_t *worker) { return false; }
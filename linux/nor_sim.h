@@ -0,0 +1,60 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef NOR_SIM_H
+#define NOR_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Simulated NOR flash for the host build of wifi_setup/flash_program.c
+ *
+ * It replaces flash_range_erase() and flash_range_program() of the pico-sdk
+ * and behaves like the real chip:
+ * - erase in sectors of 4 kB, which sets all bits to 1
+ * - program in pages of 256 bytes, which can only clear bits
+ *   (setting a bit is counted as a violation and not done)
+ * The time of each operation is taken from a configurable model and
+ * added to a simulated clock. Time spent with interrupts disabled is
+ * measured on this clock.
+ */
+#define NOR_SIM_SIZE        (64 * 1024)
+#define NOR_SIM_SECTOR_SIZE 4096
+#define NOR_SIM_PAGE_SIZE   256
+#define NOR_SIM_SECTORS     (NOR_SIM_SIZE / NOR_SIM_SECTOR_SIZE)
+
+typedef struct _nor_sim_timing {
+    uint32_t erase_us;      // per sector erase
+    uint32_t program_us;    // per page program
+    uint32_t call_us;       // per flash_range_*() call (leaving and re-entering XIP)
+} nor_sim_timing;
+
+typedef struct _nor_sim_stats {
+    uint32_t erases;
+    uint32_t pages_programmed;
+    uint32_t bit_set_violations;    // program tried to change a 0 to a 1
+    uint32_t erase_count[NOR_SIM_SECTORS];
+    uint64_t irq_off_us;            // total time with interrupts disabled
+    uint32_t irq_off_max_us;        // longest single window
+    uint32_t irq_off_windows;
+} nor_sim_stats;
+
+extern uint8_t nor_sim_flash[NOR_SIM_SIZE];
+extern nor_sim_timing nor_sim_time_model;
+extern nor_sim_stats nor_sim_stat;
+
+void nor_sim_reset();               // erased chip, counters and clock cleared
+uint64_t nor_sim_time_us();         // the simulated clock
+
+#endif // NOR_SIM_H
@@ -0,0 +1,217 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * pm_bench
+ *
+ * Measures the latency and throughput of the TCP test server for each
+ * Wi-Fi power profile (see wifi_setup/power_profile.c).
+ * For every profile it selects the profile ("pm=<name>!"), then sends
+ * short echo requests, one every "interval" ms, and reports percentiles
+ * of the round trip time. Afterwards it echoes messages of "size" bytes
+ * back to back for "seconds" and reports the throughput (both directions).
+ * The profile in use before is restored at the end. Remember: the
+ * profile is stored in flash, every run writes a few bytes.
+ *
+ * Usage: pm_bench [-n probes] [-i interval_ms] [-s size] [-d seconds]
+ *                 hostname [port [profile ...]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+
+#define TEST_PORT   4711
+#define MAX_SIZE    1024    // the server buffers 2048 bytes per message
+
+static const char *all_profiles[] = {
+    "max-performance", "balanced", "default", "power-save"
+};
+
+static int sock;
+
+static void error(const char *msg)
+{
+    perror(msg);
+    exit(1);
+}
+
+static uint64_t now_us()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void send_all(const char *buf, size_t len)
+{
+    while(len){
+        ssize_t n = write(sock, buf, len);
+        if(n <= 0)
+            error("write");
+        buf += n;
+        len -= n;
+    }
+}
+
+static void recv_all(char *buf, size_t len)
+{
+    while(len){
+        ssize_t n = read(sock, buf, len);
+        if(n <= 0)
+            error("read");
+        buf += n;
+        len -= n;
+    }
+}
+
+// Sends a command, returns the answer (a single short message)
+static const char *command(const char *cmd)
+{
+    static char answer[256];
+    ssize_t n;
+
+    send_all(cmd, strlen(cmd));
+    n = read(sock, answer, sizeof(answer) - 1);
+    if(n <= 0)
+        error("read");
+    answer[n] = '\0';
+    return answer;
+}
+
+static int compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+// Nearest rank percentile of the sorted values
+static double percentile(const uint64_t *v, int n, int p)
+{
+    int rank = (n * p + 99) / 100;
+    return v[rank > 0 ? rank - 1 : 0] / 1000.0;
+}
+
+static void measure(const char *profile, int probes, int interval_ms, int size, int seconds)
+{
+    char cmd[64], buf[MAX_SIZE];
+    uint64_t *rtt = calloc(probes, sizeof(uint64_t));
+
+    if(!rtt)
+        error("calloc");
+    snprintf(cmd, sizeof(cmd), "pm=%s!", profile);
+    const char *answer = command(cmd);
+    if(strncmp(answer, "pm=", 3) != 0){
+        printf("%-16s %s\n", profile, answer);
+        free(rtt);
+        return;
+    }
+    sleep(1);   // let the chip settle
+
+    for(int i = 0; i < probes; i++){
+        usleep(interval_ms * 1000);
+        uint64_t t = now_us();
+        send_all("p.", 2);
+        recv_all(buf, 2);
+        rtt[i] = now_us() - t;
+    }
+    qsort(rtt, probes, sizeof(uint64_t), compare);
+
+    memset(buf, 'x', size - 1);
+    buf[size - 1] = '.';
+    uint64_t bytes = 0, start = now_us(), end = start + (uint64_t)seconds * 1000000;
+    while(now_us() < end){
+        send_all(buf, size);
+        recv_all(buf, size);
+        bytes += 2 * size;
+    }
+    double s = (now_us() - start) / 1e6;
+
+    printf("%-16s %8.1f %8.1f %8.1f %8.1f %10.1f\n", profile,
+           percentile(rtt, probes, 50), percentile(rtt, probes, 90),
+           percentile(rtt, probes, 99), rtt[probes - 1] / 1000.0, bytes / s / 1024);
+    free(rtt);
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-n probes] [-i interval_ms] [-s size] [-d seconds] "
+            "hostname [port [profile ...]]\n", name);
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    int probes = 100, interval_ms = 100, size = 1000, seconds = 2;
+    int opt, port = TEST_PORT, one = 1;
+    struct sockaddr_in serv_addr;
+    struct hostent *server;
+    char restore[64];
+
+    while((opt = getopt(argc, argv, "n:i:s:d:")) != -1){
+        switch(opt){
+            case 'n': probes = atoi(optarg); break;
+            case 'i': interval_ms = atoi(optarg); break;
+            case 's': size = atoi(optarg); break;
+            case 'd': seconds = atoi(optarg); break;
+            default: usage(argv[0]);
+        }
+    }
+    if(optind >= argc || probes < 1 || interval_ms < 0 || size < 2 || size > MAX_SIZE || seconds < 1)
+        usage(argv[0]);
+    if(optind + 1 < argc)
+        port = atoi(argv[optind + 1]);
+
+    server = gethostbyname(argv[optind]);
+    if(server == NULL){
+        fprintf(stderr, "ERROR, no such host\n");
+        exit(1);
+    }
+    sock = socket(AF_INET, SOCK_STREAM, 0);
+    if(sock < 0)
+        error("ERROR opening socket");
+    memset(&serv_addr, 0, sizeof(serv_addr));
+    serv_addr.sin_family = AF_INET;
+    memcpy(&serv_addr.sin_addr.s_addr, server->h_addr, server->h_length);
+    serv_addr.sin_port = htons(port);
+    if(connect(sock, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0)
+        error("ERROR connecting");
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    snprintf(restore, sizeof(restore), "%s!", command("pm!"));
+
+    printf("%d probes every %d ms, %d byte messages for %d s\n",
+           probes, interval_ms, size, seconds);
+    printf("%-16s %8s %8s %8s %8s %10s\n", "profile", "p50 ms", "p90 ms", "p99 ms",
+           "max ms", "kB/s");
+    if(optind + 2 < argc){
+        for(int i = optind + 2; i < argc; i++)
+            measure(argv[i], probes, interval_ms, size, seconds);
+    }
+    else{
+        for(size_t i = 0; i < sizeof(all_profiles) / sizeof(all_profiles[0]); i++)
+            measure(all_profiles[i], probes, interval_ms, size, seconds);
+    }
+
+    if(strncmp(restore, "pm=", 3) == 0)
+        command(restore);
+    close(sock);
+    return 0;
+}
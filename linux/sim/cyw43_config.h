@@ -0,0 +1,6 @@
+// Host build: the time base of the DHCP server, see lwip_sim.c
+#pragma once
+
+#include <stdint.h>
+
+uint32_t cyw43_hal_ticks_ms(void);
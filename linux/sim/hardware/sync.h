@@ -0,0 +1,7 @@
+// Host build: implemented by nor_sim.c, which measures the time interrupts are off
+#pragma once
+
+#include <stdint.h>
+
+uint32_t save_and_disable_interrupts();
+void restore_interrupts(uint32_t status);
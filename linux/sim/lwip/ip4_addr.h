@@ -0,0 +1,10 @@
+// Host build: the parts of lwip/ip4_addr.h used by access_point.h
+#pragma once
+
+#include <stdint.h>
+
+typedef struct ip4_addr {
+    uint32_t addr;
+} ip4_addr_t;
+
+#define IPADDR_NONE ((uint32_t)0xffffffffUL)
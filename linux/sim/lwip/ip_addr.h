@@ -0,0 +1,11 @@
+// Host build: the parts of lwip/ip_addr.h used by the DHCP server (IPv4 only)
+#pragma once
+
+#include "lwip/ip4_addr.h"
+
+typedef ip4_addr_t ip_addr_t;
+
+#define IP4_ADDR(ipaddr, a, b, c, d) \
+    (ipaddr)->addr = (uint32_t)(d) << 24 | (uint32_t)(c) << 16 | (uint32_t)(b) << 8 | (uint32_t)(a)
+#define ip_addr_copy(dest, src)     ((dest).addr = (src).addr)
+#define ip4_addr_get_u32(ipaddr)    ((ipaddr)->addr)
@@ -0,0 +1,28 @@
+// Host build: pbufs of the DHCP server, see lwip_sim.c
+#pragma once
+
+#include <stdint.h>
+
+typedef uint8_t  u8_t;
+typedef uint16_t u16_t;
+typedef uint32_t u32_t;
+typedef int8_t   err_t;
+
+#define ERR_OK  0
+#define ERR_MEM (-1)
+
+typedef enum { PBUF_TRANSPORT, PBUF_RAW } pbuf_layer;
+typedef enum { PBUF_RAM, PBUF_POOL } pbuf_type;
+
+struct pbuf {
+    struct pbuf *next;
+    void        *payload;
+    u16_t        tot_len;
+    u16_t        len;
+};
+
+struct pbuf *pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type);
+u8_t pbuf_free(struct pbuf *p);
+void pbuf_realloc(struct pbuf *p, u16_t size);
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len, u16_t offset);
+struct pbuf *pbuf_clone(pbuf_layer layer, pbuf_type type, struct pbuf *p);
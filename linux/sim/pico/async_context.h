@@ -0,0 +1,24 @@
+// Host build: async context workers, see nor_sim.c
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct async_context async_context_t;
+
+typedef struct async_when_pending_worker {
+    void (*do_work)(async_context_t *context, struct async_when_pending_worker *worker);
+    void *user_data;
+} async_when_pending_worker_t;
+
+typedef struct async_at_time_worker {
+    void (*do_work)(async_context_t *context, struct async_at_time_worker *worker);
+    void *user_data;
+} async_at_time_worker_t;
+
+void async_context_acquire_lock_blocking(async_context_t *context);
+void async_context_release_lock(async_context_t *context);
+bool async_context_add_when_pending_worker(async_context_t *context, async_when_pending_worker_t *worker);
+void async_context_set_work_pending(async_context_t *context, async_when_pending_worker_t *worker);
+bool async_context_add_at_time_worker_in_ms(async_context_t *context, async_at_time_worker_t *worker, uint32_t ms);
+bool async_context_remove_at_time_worker(async_context_t *context, async_at_time_worker_t *worker);
@@ -0,0 +1,6 @@
+// Host build: the async context used by flash_commit_async(), see nor_sim.c
+#pragma once
+
+#include "pico/async_context.h"
+
+async_context_t *cyw43_arch_async_context();
@@ -0,0 +1,29 @@
+// Host build: the parts of pico/stdlib.h used by the flash code
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nor_sim.h"
+
+#define PICO_FLASH_SIZE_BYTES   NOR_SIM_SIZE
+#define XIP_BASE                ((uintptr_t)nor_sim_flash)
+// The program "occupies" no flash, see show_stats() and flash_init()
+#define FLASH_BINARY_END        XIP_BASE
+
+// Timer and thread mode, for trace.c
+static inline uint32_t time_us_32()
+{
+    return (uint32_t)nor_sim_time_us();
+}
+
+static inline unsigned __get_current_exception()
+{
+    return 0;
+}
+
+// Halts with a message, see flash_init()
+#define panic(...)  (fprintf(stderr, __VA_ARGS__), abort())
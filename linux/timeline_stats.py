@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+#
+# This file is part of "Wi-Fi Configure.
+#
+# Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Aggregates boot timelines into percentile tables, one per firmware
+# version.
+#
+# The input is any log (serial console or the answers to "timeline!")
+# containing lines written by timeline_dump():
+#   TIMELINE version=dev main=1021 stdio_init=1187 ...
+#
+# usage: timeline_stats.py [-d] [log ...]      (stdin if no log is given)
+#   -d  durations: time since the previous phase reached, instead of
+#       the time since boot
+
+import sys
+
+PHASES = ["main", "stdio_init", "cyw43_init", "flash_read", "force_setup",
+          "ap_start", "associated", "dhcp_bound", "tcp_listen"]
+PERCENTILES = [50, 90, 99]
+
+
+def parse(lines):
+    """Yields (version, {phase: us}) for every timeline found."""
+    for line in lines:
+        pos = line.find("TIMELINE ")
+        if pos < 0:
+            continue
+        version = "?"
+        marks = {}
+        for field in line[pos:].split()[1:]:
+            key, _, value = field.partition("=")
+            if key == "version":
+                version = value
+            elif value.isdigit():
+                marks[key] = int(value)
+        yield version, marks
+
+
+def durations(marks):
+    """Time since the previous phase reached, for every phase."""
+    result = {}
+    last = None
+    for phase in sorted(marks, key=marks.get):
+        if last is not None:
+            result[phase] = marks[phase] - last
+        last = marks[phase]
+    return result
+
+
+def percentile(values, p):
+    """Nearest rank percentile of the sorted list values."""
+    rank = max(1, -(-len(values) * p // 100))
+    return values[rank - 1]
+
+
+def print_table(version, runs, unit):
+    print("version %s: %d boots, %s in ms" % (version, len(runs), unit))
+    header = "%-12s %5s %9s" % ("phase", "n", "min")
+    header += "".join(" %9s" % ("p%d" % p) for p in PERCENTILES)
+    print(header + " %9s" % "max")
+    phases = PHASES + sorted({k for r in runs for k in r} - set(PHASES))
+    for phase in phases:
+        values = sorted(r[phase] for r in runs if phase in r)
+        if not values:
+            continue
+        row = "%-12s %5d %9.1f" % (phase, len(values), values[0] / 1000)
+        row += "".join(" %9.1f" % (percentile(values, p) / 1000) for p in PERCENTILES)
+        print(row + " %9.1f" % (values[-1] / 1000))
+    print()
+
+
+def main(argv):
+    delta = "-d" in argv
+    files = [a for a in argv if a != "-d"]
+    if any(a.startswith("-") for a in files):
+        print("usage: timeline_stats.py [-d] [log ...]", file=sys.stderr)
+        return 1
+
+    versions = {}
+    for name in files or ["-"]:
+        f = sys.stdin if name == "-" else open(name, errors="replace")
+        for version, marks in parse(f):
+            versions.setdefault(version, []).append(durations(marks) if delta else marks)
+        if f is not sys.stdin:
+            f.close()
+
+    if not versions:
+        print("no timelines found", file=sys.stderr)
+        return 1
+    for version in sorted(versions):
+        print_table(version, versions[version],
+                    "time since the previous phase" if delta else "time since boot")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -39,7 +39,10 @@
 #define LINK_STATS                  0
 // #define ETH_PAD_SIZE                2
 #define LWIP_CHKSUM_ALGORITHM       3
+// 0 leaves the DHCP client out, see WIFI_STATIC_IP_ONLY in CMakeLists.txt
+#ifndef LWIP_DHCP
 #define LWIP_DHCP                   1
+#endif
 #define LWIP_IPV4                   1
 #define LWIP_TCP                    1
 #define LWIP_UDP                    1
@@ -60,5 +63,7 @@
 #define LWIP_HTTPD_CGI 1
 // don't include the tag comment - less work for the CPU, but may be harder to debug
 #define LWIP_HTTPD_SSI_INCLUDE_TAG 0
+// a row of the stored networks table is inserted by a single tag
+#define LWIP_HTTPD_MAX_TAG_INSERT_LEN 256
 // use generated fsdata
 #define HTTPD_FSDATA_FILE "my_fsdata.c"
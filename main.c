@@ -18,10 +18,14 @@
 #include "lwipopts.h"
 
 #include "access_point.h"
+#include "config_store.h"
+#include "networks.h"
+#include "station.h"
+#include "timeline.h"
 #include "tcp_test_server.h"
 
-void print_config(config *c) {
-    if(c->magic != MAGIC) {
+void print_config(const config *c) {
+    if(!c || c->magic != MAGIC) {
         printf("No configuration found.\n");
         return;
     }
@@ -37,82 +41,133 @@ void print_config(config *c) {
 
 void clear_flash(void)
 {
-    config config;
-
     printf("Client has requested the erasure of the configuration\n");
-    flash_erase_page(WIFI_CONFIG_PAGE, 1);
-    flash_read((uint8_t *)&config, sizeof(config), WIFI_CONFIG_PAGE);
-    print_config(&config);
+    // written to flash after CONFIG_QUIET_MS
+    config_clear();
+    print_config(config_view());
+    config_show_stats();
+
+}
 
+// Called by the connection state machine, must not block
+void station_changed(station_state from, station_state to, void *arg)
+{
+    printf("Wi-Fi: %s -> %s\n", station_state_name(from), station_state_name(to));
+    cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, to == STATION_UP);
 }
 
 void main(void) {
-    config config;
+    const config *c;
+    config config;      // copy of the configuration, the flash is rewritten while connecting
+    int rc;
+    bool setup;
 
+    timeline_mark(TIMELINE_MAIN);
     stdio_init_all();
+    timeline_mark(TIMELINE_STDIO_INIT);
+    // the Config button is watched while Wi-Fi comes up
+    setup_button_start();
     if (cyw43_arch_init()) {
         printf("failed to initialise\n");
         return;
     }
+    timeline_mark(TIMELINE_CYW43_INIT);
 
     printf("Starting Wifi Configure\n");
     show_stats();
+    flash_init();
+#ifdef FLASH_BENCHMARK
+    // e.g. add_compile_definitions(FLASH_BENCHMARK=32) to CMakeLists.txt
+    flash_benchmark(FLASH_BENCHMARK);
+#endif
 
 /* Configuration code starts here */
-    flash_read((uint8_t *)&config, sizeof(config), WIFI_CONFIG_PAGE);
-
-    if(config.magic != MAGIC || forceSetup()){
-        printf("\nPico is in config mode!\n");
-
-// Modify according to your requirements.
-        // Static IP and default gateway are optional
-        run_access_point(&config, false, false);
-
-        // Static IP is required, default gateway is optional
-//      run_access_point(&config, true, false);
-        // Static IP and default gateway are required
-//      run_access_point(&config, true, true);
-
-        // store the configuration in flash memory
-        flash_write_page((uint8_t *)&config, sizeof(config), WIFI_CONFIG_PAGE);
+    // config_view() points into flash, which the station writes to
+    c = config_view();
+    if(c){
+        config = *c;
+        c = &config;
     }
-    print_config(&config);
-/* Configuration code ends here */
-
-
-/* Code for your device starts here */
-    printf("\nPico is in run mode!\n");
-    cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, 0);
-
+    timeline_mark(TIMELINE_FLASH_READ);
+
+    // Repeated, if the Config button is held while connecting
+    do {
+        // a build without DHCP client needs a static address
+        setup = !c || c->magic != MAGIC
+                || (LWIP_DHCP == 0 && c->ip.addr == IPADDR_NONE) || forceSetup();
+        timeline_mark(TIMELINE_FORCE_SETUP);
+        if(setup){
+            printf("\nPico is in config mode!\n");
+            forceSetupDone();
+            if(!c)
+                memset(&config, 0xFF, sizeof(config));
 
-/* Typical connection sequence ends here */
-    cyw43_arch_enable_sta_mode();
-    if(config.ip.addr != IPADDR_NONE){
-#if LWIP_DHCP == 1
-        dhcp_release_and_stop(netif_default);
-#endif
-        netif_set_addr(netif_default, &(config.ip), &(config.mask), &(config.gw));
-        netif_set_up(netif_default);
-#if LWIP_DHCP == 1
-        dhcp_inform(netif_default);
+// Modify according to your requirements.
+            // Static IP and default gateway are optional
+            // (static IP required if the DHCP client is left out)
+            run_access_point(&config, LWIP_DHCP == 0, false);
+
+            // Static IP is required, default gateway is optional
+//          run_access_point(&config, true, false);
+            // Static IP and default gateway are required
+//          run_access_point(&config, true, true);
+
+            // store the configuration in flash memory
+            config_set(&config);
+            config_flush();
+            // erase the standby slot now, not during a later write
+            flash_prepare_standby();
+            c = &config;
+        }
+        print_config(c);
+        config_show_stats();
+        // the network of an older configuration becomes the first one of the list
+        networks_import(c);
+        networks_print();
+
+/* Typical connection sequence starts here */
+        cyw43_arch_enable_sta_mode();
+        if(c->ip.addr != IPADDR_NONE){
+            // no DHCP traffic at all, the address is announced on link up
+            station_static_ip(c);
+            printf("Using static IP: %s\n", ip4addr_ntoa(&(c->ip)));
+        }
+        else{
+#if LWIP_DHCP
+            printf("Using DHCP: ");
+            // INIT-REBOOT with the lease of the last boot, if there is one
+            station_lease_restore();
 #endif
-        printf("Using static IP: %s\n", ip4addr_ntoa(netif_ip4_addr(netif_default)));
-    }
-    else{
-        printf("Using DHCP: ");
-    }
+        }
+
+        printf("Connecting to WiFi...\n");
+        // connects in the background and reconnects if the link is lost,
+        // tries the access point of the last connection first, then the
+        // stored networks found by a scan
+        station_start(station_changed, NULL);
+        // gives up if the Config button is held for SETUP_DELAY seconds
+        rc = station_wait(30000, forceSetup);
+        // the long press may have been confirmed right after the connection
+        if(rc != STATION_ABORTED && setup_button_stop()){
+            setup_button_start();   // watched again during the next attempt
+            rc = STATION_ABORTED;
+        }
+        if(rc == STATION_ABORTED){
+            printf("Re-run setup requested\n");
+            station_stop();
+            cyw43_arch_disable_sta_mode();
+        }
+/* Typical connection sequence ends here */
+    } while(rc == STATION_ABORTED);
+/* Configuration code ends here */
 
-    printf("Connecting to WiFi...\n");
-    if (cyw43_arch_wifi_connect_timeout_ms(config.ssid, config.passwd, CYW43_AUTH_WPA2_AES_PSK, 30000)) {
-        printf("failed to connect.\n");
-        return;
-    }
-    else {
+    if (rc)
+        printf("not connected yet, retrying in the background.\n");
+    else
         printf("connected.\n");
-        cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, 1);
-    }
-    /* Typical connection sequence ends here */
+    printf("\nPico is in run mode!\n");
 
+/* Code for your device starts here */
     // Just to show you what can be done...
     run_tcp_server(clear_flash);
 
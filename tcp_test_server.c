@@ -30,6 +30,9 @@
 #include "lwip/tcp.h"
 
 #include "tcp_test_server.h"
+#include "trace.h"
+#include "timeline.h"
+#include "power_profile.h"
 
 // #define DEBUG_printf(...) printf(__VA_ARGS__)
 #define DEBUG_printf(...)
@@ -194,6 +197,58 @@ err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err
         state->recv_len = 0;
         return tcp_server_send_data(arg, state->client_pcb);
     }
+    else if (strcmp(state->buffer_recv, "trace!") == 0) {
+        // Send the histograms of the critical sections and callbacks
+        if(!trace_dump(state->buffer_sent, BUF_SIZE))
+            strcpy(state->buffer_sent, "Nothing traced yet");
+        trace_print();
+        memset(state->buffer_recv, '\0', BUF_SIZE);
+        state->recv_len = 0;
+
+        return tcp_server_send_data(arg, state->client_pcb);
+    }
+    else if (strcmp(state->buffer_recv, "tracereset!") == 0) {
+        trace_reset();
+
+        strcpy(state->buffer_sent, "Trace reset");
+        memset(state->buffer_recv, '\0', BUF_SIZE);
+        state->recv_len = 0;
+
+        return tcp_server_send_data(arg, state->client_pcb);
+    }
+    else if (strcmp(state->buffer_recv, "timeline!") == 0) {
+        // Send the times the startup phases were reached
+        timeline_dump(state->buffer_sent, BUF_SIZE);
+        timeline_print();
+        memset(state->buffer_recv, '\0', BUF_SIZE);
+        state->recv_len = 0;
+
+        return tcp_server_send_data(arg, state->client_pcb);
+    }
+    else if (strcmp(state->buffer_recv, "pm!") == 0) {
+        // Send the power profile in use
+        sprintf(state->buffer_sent, "pm=%s", power_profile_name(power_profile_get()));
+        memset(state->buffer_recv, '\0', BUF_SIZE);
+        state->recv_len = 0;
+
+        return tcp_server_send_data(arg, state->client_pcb);
+    }
+    else if (strncmp(state->buffer_recv, "pm=", 3) == 0 &&
+             state->buffer_recv[state->recv_len - 1] == '!') {
+        // Select a power profile: "pm=balanced!"
+        state->buffer_recv[state->recv_len - 1] = '\0';
+        int profile = power_profile_parse(state->buffer_recv + 3);
+        if(profile < 0)
+            strcpy(state->buffer_sent, "Unknown power profile");
+        else if(!power_profile_set(profile))
+            strcpy(state->buffer_sent, "Can not store the power profile");
+        else
+            sprintf(state->buffer_sent, "pm=%s", power_profile_name(profile));
+        memset(state->buffer_recv, '\0', BUF_SIZE);
+        state->recv_len = 0;
+
+        return tcp_server_send_data(arg, state->client_pcb);
+    }
     else if (strcmp(state->buffer_recv, "erase!") == 0) {
             clear_config();
 
@@ -208,6 +263,16 @@ err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err
     return ERR_OK;
 }
 
+// tcp_server_recv() with its duration traced
+TRACE_SITE(recv_trace, "tcp recv");
+
+static err_t tcp_server_recv_traced(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) {
+    uint32_t t = TRACE_BEGIN();
+    err_t result = tcp_server_recv(arg, tpcb, p, err);
+    TRACE_END(recv_trace, t);
+    return result;
+}
+
 static void tcp_server_err(void *arg, err_t err) {
     if (err != ERR_ABRT) {
         DEBUG_printf("tcp_client_err_fn %d\n", err);
@@ -231,7 +296,7 @@ static err_t tcp_server_accept(void *arg, struct tcp_pcb *client_pcb, err_t err)
     state->client_pcb = client_pcb;
     tcp_arg(client_pcb, state);
     tcp_sent(client_pcb, tcp_server_sent);
-    tcp_recv(client_pcb, tcp_server_recv);
+    tcp_recv(client_pcb, tcp_server_recv_traced);
     tcp_err(client_pcb, tcp_server_err);
 
     printf("Client connected\n");
@@ -266,6 +331,8 @@ static bool tcp_server_open(void *arg) {
 
     tcp_arg(state->server_pcb, state);
     tcp_accept(state->server_pcb, tcp_server_accept);
+    timeline_mark(TIMELINE_TCP_LISTEN);
+    timeline_print();
 
     return true;
 }
@@ -16,6 +16,9 @@
 
 #include "pico/stdlib.h"
 #include "pico/cyw43_arch.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
 
 #include "lwipopts.h"
 #include "lwip/apps/httpd.h"
@@ -23,12 +26,114 @@
 #include "access_point.h"
 #include "http_server.h"
 #include "dhcp_server.h"
+#include "networks.h"
+#include "timeline.h"
 
 config *_c;
-bool isConfigured = false;
+volatile bool isConfigured = false;
 
 static void run_http_server();
 
+/*
+ * While waiting for the user, the core sleeps in __wfe(). It wakes up
+ * on every interrupt (Wi-Fi, timers, USB if stdio is on USB) and when
+ * cgi_handler() signals the end of the setup by __sev(). The LED is
+ * blinked by a worker of the cyw43 async context.
+ * The wake-ups are counted, see config_mode_wakeups().
+ */
+#define LED_BLINK_MS 250
+
+static uint32_t wakeups;
+
+static void led_work(async_context_t *context, async_at_time_worker_t *worker)
+{
+    static bool led_on = true;
+
+    led_on = !led_on;
+    cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, led_on);
+    async_context_add_at_time_worker_in_ms(context, worker, LED_BLINK_MS);
+}
+
+static async_at_time_worker_t led_worker = { .do_work = led_work };
+
+#ifndef LOCAL_TEST
+// The lease table is too large for the stack with a big pool
+static dhcp_server_t dhcp_server;
+#endif
+
+/*
+ * Provisioning scan
+ *
+ * Before the access point is started, the networks in range are scanned
+ * once. The security of the network the user enters is taken from this
+ * scan (see access_point_auth()), stored with the network and used for
+ * every later connect.
+ */
+#define SCAN_MAX        16
+#define SCAN_TIMEOUT_MS 10000
+
+typedef struct _scanned_network {
+    char    ssid[SSID_MAX_LEN + 1];
+    uint8_t auth_mode;
+} scanned_network;
+
+static scanned_network scanned[SCAN_MAX];
+static int nscanned;
+
+static int scan_result(void *env, const cyw43_ev_scan_result_t *result)
+{
+    if(result->ssid_len == 0 || result->ssid_len > SSID_MAX_LEN)
+        return 0;   // hidden network
+    for(int i = 0; i < nscanned; i++){
+        if(strlen(scanned[i].ssid) == result->ssid_len &&
+           memcmp(scanned[i].ssid, result->ssid, result->ssid_len) == 0)
+            return 0;
+    }
+    if(nscanned < SCAN_MAX){
+        memset(scanned[nscanned].ssid, 0, sizeof(scanned[nscanned].ssid));
+        memcpy(scanned[nscanned].ssid, result->ssid, result->ssid_len);
+        scanned[nscanned].auth_mode = result->auth_mode;
+        nscanned++;
+    }
+    return 0;
+}
+
+static void provision_scan()
+{
+    cyw43_wifi_scan_options_t opts;
+    absolute_time_t until = make_timeout_time_ms(SCAN_TIMEOUT_MS);
+
+    memset(&opts, 0, sizeof(opts));
+    nscanned = 0;
+    cyw43_arch_enable_sta_mode();
+    if(cyw43_wifi_scan(&cyw43_state, &opts, NULL, scan_result) == 0){
+        while(cyw43_wifi_scan_active(&cyw43_state) &&
+              absolute_time_diff_us(get_absolute_time(), until) > 0)
+            sleep_ms(10);
+    }
+    cyw43_arch_disable_sta_mode();
+
+    printf("Networks in range:\n");
+    for(int i = 0; i < nscanned; i++)
+        printf("\t\"%s\" %s\n", scanned[i].ssid,
+               networks_auth_name(networks_auth(scanned[i].auth_mode)));
+}
+
+/*
+ * access_point_auth()
+ *
+ * Returns the security of "ssid" found by the provisioning scan,
+ * NETWORK_AUTH_UNKNOWN if it was not found.
+ */
+uint32_t access_point_auth(const char *ssid)
+{
+    for(int i = 0; i < nscanned; i++){
+        if(strcmp(scanned[i].ssid, ssid) == 0)
+            return networks_auth(scanned[i].auth_mode);
+    }
+    return NETWORK_AUTH_UNKNOWN;
+}
+
 /*
  * void run_access_point(config *config,
  *                          bool require_static_ip,
@@ -49,6 +154,7 @@ void run_access_point(config *config, bool req_static_ip, bool req_def_gateway)
     _c = config;
     _need_ip = req_static_ip;
     _need_gw = req_def_gateway;
+    isConfigured = false;
 
     if(_c->magic != MAGIC){
         memset(_c->ssid, '\0', SSID_MAX_LEN);
@@ -65,6 +171,9 @@ void run_access_point(config *config, bool req_static_ip, bool req_def_gateway)
     const char *password = NULL;    // no password
 #endif
 
+    // the security of the network entered is taken from this scan
+    provision_scan();
+
 /*
  * To test the configuration page, it is recommended to run the
  * HTTP server on your local network.
@@ -72,7 +181,8 @@ void run_access_point(config *config, bool req_static_ip, bool req_def_gateway)
  * cyw43_arch_wifi_connect_timeout_ms(....).
 */
 #ifndef LOCAL_TEST
-    cyw43_arch_enable_ap_mode(ap_name, password, CYW43_AUTH_WPA2_AES_PSK);
+    cyw43_arch_enable_ap_mode(ap_name, password,
+                              password ? CYW43_AUTH_WPA2_AES_PSK : CYW43_AUTH_OPEN);
 
     ip4_addr_t ip, gw, mask;
     IP4_ADDR(&ip,   192, 168,   0, 1);
@@ -82,7 +192,6 @@ void run_access_point(config *config, bool req_static_ip, bool req_def_gateway)
     netif_set_up(netif_default);
 
     // Start the dhcp server
-    dhcp_server_t dhcp_server;
     dhcp_server_init(&dhcp_server, &gw, &mask);
 
     DEBUG_printf("Access point for configuration created\n");
@@ -104,19 +213,26 @@ void run_access_point(config *config, bool req_static_ip, bool req_def_gateway)
 
     // and the http server
     run_http_server();
+    timeline_mark(TIMELINE_AP_START);
 
+    // flash the led to show that we are in config mode
+    async_context_t *context = cyw43_arch_async_context();
+    async_context_add_at_time_worker_in_ms(context, &led_worker, 0);
+
+    uint64_t start = time_us_64();
+    wakeups = 0;
     while(!isConfigured) {
-        static absolute_time_t led_time;
-        static int led_on = true;
-
-        // flash the led to show that we are in config mode
-        if (absolute_time_diff_us(get_absolute_time(), led_time) < 0) {
-            led_on = !led_on;
-            cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, led_on);
-            led_time = make_timeout_time_ms(250);
-        }
-        sleep_ms(1);
+        __wfe();
+        wakeups++;
     }
+    uint32_t ms = (uint32_t)((time_us_64() - start) / 1000);
+    printf("Config mode: %lu wake-ups in %lu ms (%lu per second)\n",
+           (unsigned long)wakeups, (unsigned long)ms,
+           (unsigned long)(ms ? (uint64_t)wakeups * 1000 / ms : wakeups));
+
+    async_context_remove_at_time_worker(context, &led_worker);
+    cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, false);
+
     // disable config modes
 #ifndef LOCAL_TEST
     dhcp_server_deinit(&dhcp_server);
@@ -125,29 +241,118 @@ void run_access_point(config *config, bool req_static_ip, bool req_def_gateway)
     DEBUG_printf("Configuration done!\n");
 }
 
+// Wake-ups of the core during the last (or current) config mode
+uint32_t config_mode_wakeups()
+{
+    return wakeups;
+}
+
 /*
- * forceSetup()
+ * Setup button
  *
- * Checks whether the Config button is pressed during startup and
- * then for another 3 seconds.
+ * setup_button_start() enables an interrupt on both edges of SETUP_GPIO.
+ * When the button is pressed, an alarm is set to SETUP_DELAY seconds,
+ * releasing it cancels the alarm. If the alarm fires, the button has been
+ * held long enough and forceSetup() returns true from then on.
+ * So nothing waits for the button, the check runs while Wi-Fi comes up.
  */
+static volatile bool setup_pressed = false;
+static alarm_id_t setup_alarm = 0;
 
-bool forceSetup(){
+static int64_t setup_alarm_cb(alarm_id_t id, void *user_data)
+{
+    setup_alarm = 0;
+    if(!gpio_get(SETUP_GPIO))
+        setup_pressed = true;
+    return 0;
+}
+
+static void setup_gpio_irq()
+{
+    uint32_t events = gpio_get_irq_event_mask(SETUP_GPIO);
+    if(!events)
+        return;
+    gpio_acknowledge_irq(SETUP_GPIO, events);
+
+    if(setup_alarm){
+        cancel_alarm(setup_alarm);
+        setup_alarm = 0;
+    }
+    // the level tells what happened last, if both edges are pending
+    if(!gpio_get(SETUP_GPIO))
+        setup_alarm = add_alarm_in_ms(SETUP_DELAY * 1000, setup_alarm_cb, NULL, true);
+}
+
+/*
+ * setup_button_start()
+ *
+ * Starts watching SETUP_GPIO. Call it as early as possible.
+ */
+void setup_button_start()
+{
     gpio_init(SETUP_GPIO);
     gpio_set_dir(SETUP_GPIO, GPIO_IN);
     gpio_pull_up(SETUP_GPIO);
-    if(!gpio_get(SETUP_GPIO)){
-        static absolute_time_t reset_time;
-        reset_time = make_timeout_time_ms(SETUP_DELAY * 1000);
-        while (absolute_time_diff_us(get_absolute_time(), reset_time) > 0 && !gpio_get(SETUP_GPIO))
-            sleep_ms(1);
-
-        if(!gpio_get(SETUP_GPIO)){
-            DEBUG_printf("Re-run setup requested\n");
-            return true;
-        }
+    sleep_us(10);   // let the pull-up charge the line
+
+    gpio_add_raw_irq_handler(SETUP_GPIO, setup_gpio_irq);
+    gpio_set_irq_enabled(SETUP_GPIO, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+
+    // pressed already at power up
+    uint32_t interrupts = save_and_disable_interrupts();
+    if(!gpio_get(SETUP_GPIO) && !setup_alarm)
+        setup_alarm = add_alarm_in_ms(SETUP_DELAY * 1000, setup_alarm_cb, NULL, true);
+    restore_interrupts(interrupts);
+}
+
+/*
+ * setup_button_stop()
+ *
+ * Stops watching SETUP_GPIO. Returns forceSetup(), so a long press
+ * confirmed meanwhile is not lost.
+ * If the button is being held at this moment (e.g. since power up, and
+ * the station came up in less than SETUP_DELAY seconds), this waits until
+ * it is released or held long enough, at most SETUP_DELAY seconds.
+ * Otherwise it returns at once.
+ */
+bool setup_button_stop()
+{
+    // the alarm fires or the release cancels it
+    while(setup_alarm && !setup_pressed && !gpio_get(SETUP_GPIO))
+        sleep_ms(1);
+
+    gpio_set_irq_enabled(SETUP_GPIO, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, false);
+    gpio_remove_raw_irq_handler(SETUP_GPIO, setup_gpio_irq);
+
+    uint32_t interrupts = save_and_disable_interrupts();
+    if(setup_alarm){
+        cancel_alarm(setup_alarm);
+        setup_alarm = 0;
     }
-    return false;
+    restore_interrupts(interrupts);
+    return setup_pressed;
+}
+
+/*
+ * forceSetup()
+ *
+ * Returns true if the Config button has been held for SETUP_DELAY
+ * seconds since setup_button_start(). It does not wait.
+ */
+
+bool forceSetup(){
+    return setup_pressed;
+}
+
+/*
+ * forceSetupDone()
+ *
+ * Clears the request, once the setup has been run.
+ */
+
+void forceSetupDone(){
+    setup_pressed = false;
 }
 
 /*
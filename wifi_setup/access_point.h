@@ -13,6 +13,8 @@
 #ifndef ACCESS_POINT_H
 #define ACCESS_POINT_H
 
+#include <assert.h>
+
 #include "lwip/ip4_addr.h"
 #include "flash_program.h"
 
@@ -51,12 +53,21 @@ typedef struct _config {
     ip4_addr_t gw;
 } config;
 
+// The configuration is read in place from the XIP mapped flash
+static_assert(_Alignof(config) <= FLASH_VIEW_ALIGN, "config misaligned in flash");
+static_assert(sizeof(config) <= FLASH_RECORD_MAX_LEN, "config too large for flash");
+
 extern config *_c;
 extern bool _need_ip;
 extern bool _need_gw;
-extern bool isConfigured;
+extern volatile bool isConfigured;
 
+void setup_button_start();
+bool setup_button_stop();
 bool forceSetup();
+void forceSetupDone();
 void run_access_point(config *config, bool req_static_ip, bool req_def_gateway);
+uint32_t config_mode_wakeups();
+uint32_t access_point_auth(const char *ssid);
 
 #endif // ACCESS_POINT_H
@@ -0,0 +1,200 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+
+#include "config_store.h"
+#include "trace.h"
+
+/*
+ * Deferred commits of the configuration
+ *
+ * config_set() and config_clear() only update a shadow of the
+ * configuration in RAM. It is written to flash once no further update
+ * has arrived for CONFIG_QUIET_MS, by a worker of the cyw43 async context,
+ * or when config_flush() is called. A burst of updates costs a single
+ * flash write.
+ * While an update is pending, config_view() returns the shadow,
+ * otherwise the configuration in flash (no copy).
+ * Without an async context (before cyw43_arch_init()) updates are
+ * only committed by config_flush().
+ */
+typedef enum _shadow_state {
+    SHADOW_CLEAN,       // flash is up to date
+    SHADOW_DIRTY,       // shadow holds a new configuration
+    SHADOW_DELETED      // configuration is to be deleted
+} shadow_state;
+
+static config shadow;
+static shadow_state state = SHADOW_CLEAN;
+static config_store_stats stats;
+
+static void quiet_work(async_context_t *context, async_at_time_worker_t *worker);
+static async_at_time_worker_t quiet_worker = { .do_work = quiet_work };
+
+static inline void store_lock()
+{
+    async_context_t *context = cyw43_arch_async_context();
+    if(context)
+        async_context_acquire_lock_blocking(context);
+}
+
+static inline void store_unlock()
+{
+    async_context_t *context = cyw43_arch_async_context();
+    if(context)
+        async_context_release_lock(context);
+}
+
+// Sets the new state and (re)starts the quiet period, the lock must be held
+static void schedule_commit(shadow_state new_state)
+{
+    async_context_t *context = cyw43_arch_async_context();
+
+    stats.updates++;
+    if(state != SHADOW_CLEAN)
+        stats.coalesced++;  // replaces an update not yet written
+    state = new_state;
+    if(context){
+        async_context_remove_at_time_worker(context, &quiet_worker);
+        async_context_add_at_time_worker_in_ms(context, &quiet_worker, CONFIG_QUIET_MS);
+    }
+}
+
+// Writes the shadow to flash, the lock must be held
+static bool commit()
+{
+    flash_write_result result;
+
+    switch(state){
+        case SHADOW_DIRTY:
+            result = kv_put(WIFI_CONFIG_KEY, &shadow, sizeof(shadow));
+            break;
+        case SHADOW_DELETED:
+            result = kv_delete(WIFI_CONFIG_KEY);
+            break;
+        default:
+            return true;
+    }
+    if(result == FLASH_WRITE_FAILED)
+        return false;
+
+    state = SHADOW_CLEAN;
+    stats.commits++;
+    if(result == FLASH_WRITE_SKIPPED)
+        stats.skipped++;
+    return true;
+}
+
+// The quiet period is over, the device is idle
+TRACE_SITE(commit_trace, "config commit");
+
+static void quiet_work(async_context_t *context, async_at_time_worker_t *worker)
+{
+    uint32_t t = TRACE_BEGIN();
+    if(!commit())
+        printf("ERROR: can not write the configuration to flash\n");
+    TRACE_END(commit_trace, t);
+}
+
+/*
+ * config_view()
+ *
+ * Returns the configuration, NULL if there is none.
+ * The pointer is valid until the next update.
+ */
+const config *config_view()
+{
+    const config *c = NULL;
+    uint16_t len;
+
+    store_lock();
+    if(state == SHADOW_DIRTY)
+        c = &shadow;
+    else if(state == SHADOW_CLEAN){
+        c = (const config *)kv_get(WIFI_CONFIG_KEY, &len);
+        if(len < sizeof(config))
+            c = NULL;
+    }
+    store_unlock();
+    return c;
+}
+
+/*
+ * config_set()
+ *
+ * Stores "c" as the new configuration.
+ * It is written to flash after CONFIG_QUIET_MS, or by config_flush().
+ */
+void config_set(const config *c)
+{
+    store_lock();
+    if(c != &shadow)
+        shadow = *c;
+    schedule_commit(SHADOW_DIRTY);
+    store_unlock();
+}
+
+/*
+ * config_clear()
+ *
+ * Deletes the configuration, deferred like config_set().
+ */
+void config_clear()
+{
+    store_lock();
+    schedule_commit(SHADOW_DELETED);
+    store_unlock();
+}
+
+/*
+ * config_flush()
+ *
+ * Writes a pending update to flash now, e.g. before a reboot.
+ * Returns false if the flash could not be written.
+ */
+bool config_flush()
+{
+    async_context_t *context = cyw43_arch_async_context();
+    bool ok;
+
+    store_lock();
+    if(context)
+        async_context_remove_at_time_worker(context, &quiet_worker);
+    ok = commit();
+    store_unlock();
+    return ok;
+}
+
+void config_get_stats(config_store_stats *s)
+{
+    store_lock();
+    *s = stats;
+    store_unlock();
+}
+
+// Prints how many flash writes were saved by deferring the commits
+void config_show_stats()
+{
+    config_store_stats s;
+
+    config_get_stats(&s);
+    printf("Configuration: %lu updates, %lu commits, %lu flash writes saved "
+           "(%lu coalesced, %lu unchanged)\n",
+           (unsigned long)s.updates, (unsigned long)s.commits,
+           (unsigned long)(s.coalesced + s.skipped),
+           (unsigned long)s.coalesced, (unsigned long)s.skipped);
+}
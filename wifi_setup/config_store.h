@@ -0,0 +1,36 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include "access_point.h"
+
+// Updates are committed to flash after this time without further updates
+#define CONFIG_QUIET_MS 2000
+
+// Counters of the deferred commits
+typedef struct _config_store_stats {
+    uint32_t updates;           // calls of config_set() and config_clear()
+    uint32_t commits;           // pending updates written to flash
+    uint32_t coalesced;         // updates replaced before they were written
+    uint32_t skipped;           // commits of unchanged data, nothing written
+} config_store_stats;
+
+const config *config_view();
+void config_set(const config *c);
+void config_clear();
+bool config_flush();
+void config_get_stats(config_store_stats *s);
+void config_show_stats();
+
+#endif // CONFIG_STORE_H
@@ -0,0 +1,102 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include "dhcp_options.h"
+
+static const uint8_t magic_cookie[DHCP_MAGIC_COOKIE_LEN] = { 99, 130, 83, 99 };
+
+/*
+ * dhcp_options_parse()
+ *
+ * Parses the "len" bytes of the options field of a request ("options",
+ * starting with the magic cookie) into "o" in a single pass. Returns
+ * DHCP_OPTIONS_OK if the options are well formed up to the END option
+ * (or the end of the data) and contain a message type.
+ */
+dhcp_options_status dhcp_options_parse(const uint8_t *options, size_t len, dhcp_options *o)
+{
+    size_t i = DHCP_MAGIC_COOKIE_LEN;
+
+    memset(o, 0, sizeof(*o));
+    if(len < DHCP_MAGIC_COOKIE_LEN || memcmp(options, magic_cookie, DHCP_MAGIC_COOKIE_LEN) != 0)
+        return DHCP_OPTIONS_NO_COOKIE;
+
+    while(i < len){
+        uint8_t code = options[i];
+
+        if(code == DHCP_OPTION_PAD){
+            i++;
+            continue;
+        }
+        if(code == DHCP_OPTION_END)
+            break;
+        // code, length and value must be in the data
+        if(len - i < 2 || len - i - 2 < options[i + 1])
+            return DHCP_OPTIONS_TRUNCATED;
+
+        uint8_t n = options[i + 1];
+        const uint8_t *value = &options[i + 2];
+
+        switch(code){
+            case DHCP_OPTION_MSG_TYPE:
+                if(n != 1)
+                    return DHCP_OPTIONS_BAD_LENGTH;
+                if(!o->type)
+                    o->type = value[0];
+                break;
+
+            case DHCP_OPTION_REQUESTED_IP:
+                if(n != 4)
+                    return DHCP_OPTIONS_BAD_LENGTH;
+                if(!o->requested_ip)
+                    o->requested_ip = value;
+                break;
+
+            case DHCP_OPTION_SERVER_ID:
+                if(n != 4)
+                    return DHCP_OPTIONS_BAD_LENGTH;
+                if(!o->server_id)
+                    o->server_id = value;
+                break;
+
+            case DHCP_OPTION_PARAM_REQUEST_LIST:
+                if(!o->param_request_list){
+                    o->param_request_list = value;
+                    o->param_request_len = n;
+                }
+                break;
+
+            case DHCP_OPTION_RAPID_COMMIT:
+                if(n != 0)
+                    return DHCP_OPTIONS_BAD_LENGTH;
+                o->rapid_commit = true;
+                break;
+        }
+        o->count++;
+        i += 2 + n;
+    }
+    return o->type ? DHCP_OPTIONS_OK : DHCP_OPTIONS_NO_TYPE;
+}
+
+const char *dhcp_options_status_name(dhcp_options_status status)
+{
+    switch(status){
+        case DHCP_OPTIONS_OK:           return "ok";
+        case DHCP_OPTIONS_NO_COOKIE:    return "no cookie";
+        case DHCP_OPTIONS_TRUNCATED:    return "truncated";
+        case DHCP_OPTIONS_BAD_LENGTH:   return "bad length";
+        case DHCP_OPTIONS_NO_TYPE:      return "no type";
+    }
+    return "?";
+}
@@ -0,0 +1,72 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef DHCP_OPTIONS_H
+#define DHCP_OPTIONS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Options of a DHCP request
+ *
+ * dhcp_options_parse() walks the options once and keeps the ones the
+ * DHCP server uses in a dhcp_options table. Every length is checked
+ * against the received data, an option that runs past the end rejects
+ * the request. The message type may be anywhere in the options.
+ * Options in the "sname" and "file" fields (overload, option 52) are
+ * not looked at.
+ */
+
+#define DHCP_OPTION_PAD                 0
+#define DHCP_OPTION_SUBNET_MASK         1
+#define DHCP_OPTION_ROUTER              3
+#define DHCP_OPTION_DNS                 6
+#define DHCP_OPTION_HOST_NAME           12
+#define DHCP_OPTION_REQUESTED_IP        50
+#define DHCP_OPTION_IP_LEASE_TIME       51
+#define DHCP_OPTION_MSG_TYPE            53
+#define DHCP_OPTION_SERVER_ID           54
+#define DHCP_OPTION_PARAM_REQUEST_LIST  55
+#define DHCP_OPTION_MAX_MSG_SIZE        57
+#define DHCP_OPTION_VENDOR_CLASS_ID     60
+#define DHCP_OPTION_CLIENT_ID           61
+#define DHCP_OPTION_RAPID_COMMIT        80
+#define DHCP_OPTION_END                 255
+
+#define DHCP_MAGIC_COOKIE_LEN           4
+
+typedef enum _dhcp_options_status {
+    DHCP_OPTIONS_OK,
+    DHCP_OPTIONS_NO_COOKIE,     // too short or wrong magic cookie
+    DHCP_OPTIONS_TRUNCATED,     // an option runs past the end
+    DHCP_OPTIONS_BAD_LENGTH,    // wrong length of a fixed size option
+    DHCP_OPTIONS_NO_TYPE,       // no message type
+} dhcp_options_status;
+
+// The options used by the server, NULL/0 if not present. Only the first
+// of repeated options counts.
+typedef struct _dhcp_options {
+    uint8_t        type;                // message type, 1 (DISCOVER) ... 8 (INFORM)
+    const uint8_t *requested_ip;        // 4 bytes
+    const uint8_t *server_id;           // 4 bytes
+    const uint8_t *param_request_list;  // option codes
+    uint8_t        param_request_len;
+    bool           rapid_commit;
+    uint8_t        count;               // options found, PAD and END not counted
+} dhcp_options;
+
+dhcp_options_status dhcp_options_parse(const uint8_t *options, size_t len, dhcp_options *o);
+const char *dhcp_options_status_name(dhcp_options_status status);
+
+#endif // DHCP_OPTIONS_H
@@ -28,14 +28,19 @@
 //  https://www.ietf.org/rfc/rfc2131.txt
 //  https://tools.ietf.org/html/rfc2132 -- DHCP Options and BOOTP Vendor Extensions
 
+#include <assert.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 #include <errno.h>
 
 #include "cyw43_config.h"
+#include "pico/cyw43_arch.h"
 #include "dhcp_server.h"
+#include "dhcp_options.h"
 #include "lwip/udp.h"
 #include "access_point.h"
+#include "trace.h"
 
 #define DHCPDISCOVER    (1)
 #define DHCPOFFER       (2)
@@ -46,31 +51,21 @@
 #define DHCPRELEASE     (7)
 #define DHCPINFORM      (8)
 
-#define DHCP_OPT_PAD                (0)
-#define DHCP_OPT_SUBNET_MASK        (1)
-#define DHCP_OPT_ROUTER             (3)
-#define DHCP_OPT_DNS                (6)
-#define DHCP_OPT_HOST_NAME          (12)
-#define DHCP_OPT_REQUESTED_IP       (50)
-#define DHCP_OPT_IP_LEASE_TIME      (51)
-#define DHCP_OPT_MSG_TYPE           (53)
-#define DHCP_OPT_SERVER_ID          (54)
-#define DHCP_OPT_PARAM_REQUEST_LIST (55)
-#define DHCP_OPT_MAX_MSG_SIZE       (57)
-#define DHCP_OPT_VENDOR_CLASS_ID    (60)
-#define DHCP_OPT_CLIENT_ID          (61)
-#define DHCP_OPT_END                (255)
-
 #define PORT_DHCP_SERVER (67)
 #define PORT_DHCP_CLIENT (68)
 
 #define DEFAULT_DNS MAKE_IP4(8, 8, 8, 8)
 #define DEFAULT_LEASE_TIME_S (24 * 60 * 60) // in seconds
+#define OFFER_TIME_S (30) // an offered address is kept for the client this long
+#define DECLINE_TIME_S (10 * 60) // a declined address is not given out for this long
 
 #define MAC_LEN (6)
 #define MAKE_IP4(a, b, c, d) ((a) << 24 | (b) << 16 | (c) << 8 | (d))
 
-typedef struct {
+// Requests are parsed in place from the received pbuf, where the message
+// may be at any alignment (UDP payload at offset 42 of the frame), so the
+// compiler must use byte accesses
+typedef struct __attribute__((packed)) {
     uint8_t op; // message opcode
     uint8_t htype; // hardware address type
     uint8_t hlen; // hardware address length
@@ -88,6 +83,76 @@ typedef struct {
     uint8_t options[312]; // optional parameters, variable, starts with magic
 } dhcp_msg_t;
 
+#define DHCP_OPTIONS_OFFSET offsetof(dhcp_msg_t, options)
+#define DHCP_MIN_SIZE (DHCP_OPTIONS_OFFSET + DHCP_MAGIC_COOKIE_LEN + 3) // magic and message type
+#define BOOTREQUEST (1)
+
+// Magic, message type, rapid commit, the parameters, end
+#define DHCP_REPLY_SIZE (DHCP_OPTIONS_OFFSET + DHCP_MAGIC_COOKIE_LEN + 3 + 2 + DHCPS_TEMPLATE_OPTS * DHCPS_TEMPLATE_OPT_LEN + 1)
+
+// Cycles spent per message type, counted with SysTick (see dhcp_server_init()),
+// e.g. add_compile_definitions(DHCPS_CYCLE_COUNT=1) to CMakeLists.txt
+#ifndef DHCPS_CYCLE_COUNT
+#define DHCPS_CYCLE_COUNT 0
+#endif
+
+#if DHCPS_CYCLE_COUNT
+#include "hardware/structs/systick.h"
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} dhcp_cycles_t;
+
+static dhcp_cycles_t dhcp_cycles[DHCPINFORM + 1];
+
+static void dhcp_cycles_start(void) {
+    systick_hw->rvr = 0xffffff;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // enabled, processor clock, no interrupt
+    memset(dhcp_cycles, 0, sizeof(dhcp_cycles));
+}
+
+static inline uint32_t dhcp_cycles_now(void) {
+    return systick_hw->cvr;
+}
+
+static void dhcp_cycles_record(uint8_t type, uint32_t start) {
+    // SysTick is a 24 bit down counter
+    uint32_t c = (start - systick_hw->cvr) & 0xffffff;
+    dhcp_cycles_t *s = &dhcp_cycles[type <= DHCPINFORM ? type : 0];
+    if (s->count == 0 || c < s->min) {
+        s->min = c;
+    }
+    if (c > s->max) {
+        s->max = c;
+    }
+    s->total += c;
+    s->count++;
+}
+
+static void dhcp_cycles_print(void) {
+    static const char *const name[] = {
+        "other", "DISCOVER", "OFFER", "REQUEST", "DECLINE", "ACK", "NAK", "RELEASE", "INFORM"
+    };
+    for (int i = 0; i <= DHCPINFORM; ++i) {
+        const dhcp_cycles_t *s = &dhcp_cycles[i];
+        if (s->count) {
+            printf("DHCPS: %-8s %5lu x, cycles avg %lu min %lu max %lu\n", name[i],
+                (unsigned long)s->count, (unsigned long)(s->total / s->count),
+                (unsigned long)s->min, (unsigned long)s->max);
+        }
+    }
+}
+#else
+#define dhcp_cycles_start()
+#define dhcp_cycles_now() 0
+#define dhcp_cycles_record(type, start) ((void)(type), (void)(start))
+#define dhcp_cycles_print()
+#endif
+
 static int dhcp_socket_new_dgram(struct udp_pcb **udp, void *cb_data, udp_recv_fn cb_udp_recv) {
     // family is AF_INET
     // type is SOCK_DGRAM
@@ -117,42 +182,7 @@ static int dhcp_socket_bind(struct udp_pcb **udp, uint32_t ip, uint16_t port) {
     return udp_bind(*udp, &addr, port);
 }
 
-static int dhcp_socket_sendto(struct udp_pcb **udp, const void *buf, size_t len, uint32_t ip, uint16_t port) {
-    if (len > 0xffff) {
-        len = 0xffff;
-    }
-
-    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, len, PBUF_RAM);
-    if (p == NULL) {
-        return -ENOMEM;
-    }
-
-    memcpy(p->payload, buf, len);
-
-    ip_addr_t dest;
-    IP4_ADDR(&dest, ip >> 24 & 0xff, ip >> 16 & 0xff, ip >> 8 & 0xff, ip & 0xff);
-    err_t err = udp_sendto(*udp, p, &dest, port);
-
-    pbuf_free(p);
-
-    if (err != ERR_OK) {
-        return err;
-    }
-
-    return len;
-}
-
-static uint8_t *opt_find(uint8_t *opt, uint8_t cmd) {
-    for (int i = 0; i < 308 && opt[i] != DHCP_OPT_END;) {
-        if (opt[i] == cmd) {
-            return &opt[i];
-        }
-        i += 2 + opt[i + 1];
-    }
-    return NULL;
-}
-
-static void opt_write_n(uint8_t **opt, uint8_t cmd, size_t n, void *data) {
+static void opt_write_n(uint8_t **opt, uint8_t cmd, size_t n, const void *data) {
     uint8_t *o = *opt;
     *o++ = cmd;
     *o++ = n;
@@ -179,119 +209,501 @@ static void opt_write_u32(uint8_t **opt, uint8_t cmd, uint32_t val) {
     *opt = o;
 }
 
+// Lease table
+//
+// Every lease is in exactly one of these lists:
+//  - free list: unused, the longest unused first. An expired lease keeps
+//    its MAC (and stays in the MAC index) until it is reused, so a client
+//    coming back gets its old address if it is still available.
+//  - timer wheel: offered, bound and declined leases, in the slot of their
+//    expiry.
+//  - neither: the server's own address.
+// The MAC index holds every lease with a MAC, in one of DHCPS_HASH_SIZE
+// singly linked buckets.
+
+enum {
+    LEASE_FREE,
+    LEASE_OFFERED,
+    LEASE_BOUND,
+    LEASE_DECLINED,
+    LEASE_RESERVED,
+};
+
+static const uint8_t mac_none[MAC_LEN];
+
+static inline uint32_t lease_hash(const uint8_t *mac) {
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < MAC_LEN; ++i) {
+        h = (h ^ mac[i]) * 16777619u;
+    }
+    return (h ^ h >> 16) & (DHCPS_HASH_SIZE - 1);
+}
+
+static uint8_t lease_find(dhcp_server_t *d, const uint8_t *mac) {
+    uint8_t i = d->hash[lease_hash(mac)];
+    while (i != DHCPS_NONE && memcmp(d->lease[i].mac, mac, MAC_LEN) != 0) {
+        i = d->lease[i].next;
+    }
+    return i;
+}
+
+static void hash_insert(dhcp_server_t *d, uint8_t i) {
+    uint8_t *head = &d->hash[lease_hash(d->lease[i].mac)];
+    d->lease[i].next = *head;
+    *head = i;
+}
+
+static void hash_remove(dhcp_server_t *d, uint8_t i) {
+    uint8_t *p = &d->hash[lease_hash(d->lease[i].mac)];
+    while (*p != DHCPS_NONE) {
+        if (*p == i) {
+            *p = d->lease[i].next;
+            break;
+        }
+        p = &d->lease[*p].next;
+    }
+}
+
+static void free_push(dhcp_server_t *d, uint8_t i) {
+    dhcp_server_lease_t *l = &d->lease[i];
+    l->state = LEASE_FREE;
+    l->free_next = DHCPS_NONE;
+    l->free_prev = d->free_tail;
+    if (d->free_tail != DHCPS_NONE) {
+        d->lease[d->free_tail].free_next = i;
+    } else {
+        d->free_head = i;
+    }
+    d->free_tail = i;
+}
+
+static void free_remove(dhcp_server_t *d, uint8_t i) {
+    dhcp_server_lease_t *l = &d->lease[i];
+    if (l->free_prev != DHCPS_NONE) {
+        d->lease[l->free_prev].free_next = l->free_next;
+    } else {
+        d->free_head = l->free_next;
+    }
+    if (l->free_next != DHCPS_NONE) {
+        d->lease[l->free_next].free_prev = l->free_prev;
+    } else {
+        d->free_tail = l->free_prev;
+    }
+}
+
+static void dhcp_expiry_work(async_context_t *context, async_at_time_worker_t *worker);
+
+static inline uint8_t *wheel_slot(dhcp_server_t *d, uint32_t ms) {
+    return &d->wheel[ms / DHCPS_WHEEL_TICK_MS % DHCPS_WHEEL_SLOTS];
+}
+
+static void wheel_insert(dhcp_server_t *d, uint8_t i) {
+    dhcp_server_lease_t *l = &d->lease[i];
+    uint8_t *head = wheel_slot(d, l->expiry);
+    l->wheel_prev = DHCPS_NONE;
+    l->wheel_next = *head;
+    if (*head != DHCPS_NONE) {
+        d->lease[*head].wheel_prev = i;
+    }
+    *head = i;
+    d->wheel_count++;
+    if (!d->expiry_scheduled) {
+        d->expiry_scheduled = async_context_add_at_time_worker_in_ms(cyw43_arch_async_context(),
+            &d->expiry_worker, DHCPS_WHEEL_TICK_MS);
+    }
+}
+
+static void wheel_remove(dhcp_server_t *d, uint8_t i) {
+    dhcp_server_lease_t *l = &d->lease[i];
+    if (l->wheel_prev != DHCPS_NONE) {
+        d->lease[l->wheel_prev].wheel_next = l->wheel_next;
+    } else {
+        *wheel_slot(d, l->expiry) = l->wheel_next;
+    }
+    if (l->wheel_next != DHCPS_NONE) {
+        d->lease[l->wheel_next].wheel_prev = l->wheel_prev;
+    }
+    d->wheel_count--;
+}
+
+// Gives lease "i" to "mac" for "seconds"
+static void lease_set(dhcp_server_t *d, uint8_t i, const uint8_t *mac, uint8_t state, uint32_t seconds) {
+    dhcp_server_lease_t *l = &d->lease[i];
+    if (l->state == LEASE_FREE) {
+        free_remove(d, i);
+    } else {
+        wheel_remove(d, i);
+    }
+    if (memcmp(l->mac, mac, MAC_LEN) != 0) {
+        // a client has a single lease
+        uint8_t old = lease_find(d, mac);
+        if (old != DHCPS_NONE) {
+            if (d->lease[old].state != LEASE_FREE) {
+                wheel_remove(d, old);
+                free_push(d, old);
+            }
+            hash_remove(d, old);
+            memset(d->lease[old].mac, 0, MAC_LEN);
+        }
+        if (memcmp(l->mac, mac_none, MAC_LEN) != 0) {
+            hash_remove(d, i);
+        }
+        memcpy(l->mac, mac, MAC_LEN);
+        hash_insert(d, i);
+    }
+    l->state = state;
+    l->expiry = cyw43_hal_ticks_ms() + seconds * 1000;
+    wheel_insert(d, i);
+}
+
+// Returns an offered or bound lease to the free list, it keeps its MAC
+static void lease_release(dhcp_server_t *d, uint8_t i) {
+    wheel_remove(d, i);
+    free_push(d, i);
+}
+
+// Another host uses the address of lease "i", it is not given out for a while
+static void lease_decline(dhcp_server_t *d, uint8_t i) {
+    dhcp_server_lease_t *l = &d->lease[i];
+    wheel_remove(d, i);
+    hash_remove(d, i);
+    memset(l->mac, 0, MAC_LEN);
+    l->state = LEASE_DECLINED;
+    l->expiry = cyw43_hal_ticks_ms() + DECLINE_TIME_S * 1000;
+    wheel_insert(d, i);
+}
+
+// Returns the lease of address "ip", DHCPS_NONE if it is not in the pool
+static uint8_t lease_of(const dhcp_server_t *d, const uint8_t *ip) {
+    if (memcmp(ip, &d->ip.addr, 3) != 0) {
+        return DHCPS_NONE;
+    }
+    uint8_t i = ip[3] - DHCPS_BASE_IP;
+    return i < DHCPS_MAX_IP ? i : DHCPS_NONE;
+}
+
+// Returns true if lease "i" is offered or bound to "mac"
+static bool lease_held(const dhcp_server_t *d, uint8_t i, const uint8_t *mac) {
+    const dhcp_server_lease_t *l = &d->lease[i];
+    return (l->state == LEASE_OFFERED || l->state == LEASE_BOUND) && memcmp(l->mac, mac, MAC_LEN) == 0;
+}
+
+// Checks the slots of the timer wheel that are complete at "now"
+static void lease_expire(dhcp_server_t *d, uint32_t now) {
+    for (int n = 0; n < DHCPS_WHEEL_SLOTS && (int32_t)(now - d->wheel_time) >= DHCPS_WHEEL_TICK_MS; ++n) {
+        uint8_t i = *wheel_slot(d, d->wheel_time);
+        while (i != DHCPS_NONE) {
+            uint8_t next = d->lease[i].wheel_next;
+            if ((int32_t)(d->lease[i].expiry - now) <= 0) {
+                lease_release(d, i);
+            }
+            i = next;
+        }
+        d->wheel_time += DHCPS_WHEEL_TICK_MS;
+    }
+    if ((int32_t)(now - d->wheel_time) >= DHCPS_WHEEL_TICK_MS) {
+        // all slots have been checked
+        d->wheel_time = now - now % DHCPS_WHEEL_TICK_MS;
+    }
+}
+
+static void dhcp_expiry_work(async_context_t *context, async_at_time_worker_t *worker) {
+    dhcp_server_t *d = (dhcp_server_t *)worker->user_data;
+    lease_expire(d, cyw43_hal_ticks_ms());
+    d->expiry_scheduled = d->wheel_count != 0
+        && async_context_add_at_time_worker_in_ms(context, worker, DHCPS_WHEEL_TICK_MS);
+}
+
+static void lease_init(dhcp_server_t *d) {
+    memset(d->lease, 0, sizeof(d->lease));
+    memset(d->hash, DHCPS_NONE, sizeof(d->hash));
+    memset(d->wheel, DHCPS_NONE, sizeof(d->wheel));
+    d->free_head = d->free_tail = DHCPS_NONE;
+    d->wheel_count = 0;
+    uint32_t now = cyw43_hal_ticks_ms();
+    d->wheel_time = now - now % DHCPS_WHEEL_TICK_MS;
+    d->expiry_scheduled = false;
+    d->expiry_worker.do_work = dhcp_expiry_work;
+    d->expiry_worker.user_data = d;
+
+    uint8_t own = ((const uint8_t *)&d->ip.addr)[3] - DHCPS_BASE_IP;
+    for (int i = 0; i < DHCPS_MAX_IP; ++i) {
+        if (i == own) {
+            d->lease[i].state = LEASE_RESERVED;
+        } else {
+            free_push(d, i);
+        }
+    }
+}
+
+static void dhcp_log(const char *event, const uint8_t *mac, const uint8_t *ip) {
+    DEBUG_printf("DHCPS: %s: MAC=%02x:%02x:%02x:%02x:%02x:%02x IP=%u.%u.%u.%u\n", event,
+        mac[0], mac[1], mac[2], mac[3], mac[4], mac[5], ip[0], ip[1], ip[2], ip[3]);
+}
+
+// Parameters of the replies, in the order of a reply without a parameter
+// request list
+enum {
+    TMPL_SERVER_ID,
+    TMPL_SUBNET_MASK,
+    TMPL_ROUTER,
+    TMPL_DNS,
+    TMPL_IP_LEASE_TIME,
+    TMPL_NONE = DHCPS_TEMPLATE_OPTS,
+};
+
+static_assert(TMPL_NONE <= 32, "template entries must fit a bit mask");
+
+static void tmpl_init(dhcp_server_t *d) {
+    uint8_t *opt;
+    opt = d->tmpl[TMPL_SERVER_ID];
+    opt_write_n(&opt, DHCP_OPTION_SERVER_ID, 4, &d->ip.addr);
+    opt = d->tmpl[TMPL_SUBNET_MASK];
+    opt_write_n(&opt, DHCP_OPTION_SUBNET_MASK, 4, &d->nm.addr);
+    opt = d->tmpl[TMPL_ROUTER];
+    opt_write_n(&opt, DHCP_OPTION_ROUTER, 4, &d->ip.addr); // aka gateway; can have mulitple addresses
+    opt = d->tmpl[TMPL_DNS];
+    opt_write_u32(&opt, DHCP_OPTION_DNS, DEFAULT_DNS); // can have mulitple addresses
+    opt = d->tmpl[TMPL_IP_LEASE_TIME];
+    opt_write_u32(&opt, DHCP_OPTION_IP_LEASE_TIME, DEFAULT_LEASE_TIME_S);
+}
+
+static inline int tmpl_index(uint8_t code) {
+    switch (code) {
+        case DHCP_OPTION_SERVER_ID: return TMPL_SERVER_ID;
+        case DHCP_OPTION_SUBNET_MASK: return TMPL_SUBNET_MASK;
+        case DHCP_OPTION_ROUTER: return TMPL_ROUTER;
+        case DHCP_OPTION_DNS: return TMPL_DNS;
+        case DHCP_OPTION_IP_LEASE_TIME: return TMPL_IP_LEASE_TIME;
+        default: return TMPL_NONE;
+    }
+}
+
+// Writes the parameters the client asked for in its parameter request list,
+// in its order, and the server id and lease time, which every reply
+// has. Without a list, all parameters. INFORM gets no lease time.
+static uint8_t *opt_write_params(const dhcp_server_t *d, uint8_t *opt, const dhcp_options *req_opt, bool lease) {
+    const uint8_t *prl = req_opt->param_request_list;
+    uint32_t wanted = 1u << TMPL_SERVER_ID | (uint32_t)lease << TMPL_IP_LEASE_TIME;
+    if (prl == NULL) {
+        wanted = lease ? (1u << TMPL_NONE) - 1 : (1u << TMPL_IP_LEASE_TIME) - 1;
+    } else {
+        uint32_t allowed = lease ? (1u << TMPL_NONE) - 1 : (1u << TMPL_IP_LEASE_TIME) - 1;
+        for (int i = 0; i < req_opt->param_request_len; ++i) {
+            int k = tmpl_index(prl[i]);
+            if (k != TMPL_NONE && (allowed & 1u << k)) {
+                allowed &= ~(1u << k);
+                wanted &= ~(1u << k);
+                memcpy(opt, d->tmpl[k], DHCPS_TEMPLATE_OPT_LEN);
+                opt += DHCPS_TEMPLATE_OPT_LEN;
+            }
+        }
+    }
+    for (int k = 0; wanted != 0; ++k, wanted >>= 1) {
+        if (wanted & 1) {
+            memcpy(opt, d->tmpl[k], DHCPS_TEMPLATE_OPT_LEN);
+            opt += DHCPS_TEMPLATE_OPT_LEN;
+        }
+    }
+    return opt;
+}
+
+TRACE_SITE(dhcp_trace, "dhcp server");
+
 static void dhcp_server_process(void *arg, struct udp_pcb *upcb, struct pbuf *p, const ip_addr_t *src_addr, u16_t src_port) {
+    uint32_t t = TRACE_BEGIN();
+    uint32_t cycles = dhcp_cycles_now();
     dhcp_server_t *d = (dhcp_server_t *)arg;
     (void)upcb;
     (void)src_addr;
     (void)src_port;
 
-    // This is around 548 bytes
-    dhcp_msg_t dhcp_msg;
-    uint8_t *opt;
-    size_t len;
+    struct pbuf *contiguous = NULL;
+    struct pbuf *reply = NULL;
+    uint8_t type = 0;
 
-    #define DHCP_MIN_SIZE (240 + 3)
     if (p->tot_len < DHCP_MIN_SIZE) {
         goto ignore_request;
     }
 
-    len = pbuf_copy_partial(p, &dhcp_msg, sizeof(dhcp_msg), 0);
-    if (len < DHCP_MIN_SIZE) {
+    // Parse the request in place. The Wi-Fi driver delivers a frame in a
+    // single pbuf, a chain is only flattened for safety.
+    if (p->len < p->tot_len) {
+        contiguous = pbuf_clone(PBUF_RAW, PBUF_RAM, p);
+        if (contiguous == NULL) {
+            goto ignore_request;
+        }
+    }
+    const struct pbuf *in = contiguous ? contiguous : p;
+    const dhcp_msg_t *req = (const dhcp_msg_t *)in->payload;
+    dhcp_options req_opt;
+    if (req->op != BOOTREQUEST
+        || dhcp_options_parse(req->options, in->len - DHCP_OPTIONS_OFFSET, &req_opt) != DHCP_OPTIONS_OK) {
         goto ignore_request;
     }
+    type = req_opt.type;
 
-    dhcp_msg.op = DHCPOFFER;
-    memcpy(&dhcp_msg.yiaddr, &d->ip.addr, 4);
+    lease_expire(d, cyw43_hal_ticks_ms());
 
-    opt = (uint8_t *)&dhcp_msg.options;
-    opt += 4; // assume magic cookie: 99, 130, 83, 99
-
-    switch (opt[2]) {
+    uint8_t yi = DHCPS_NONE;
+    uint8_t reply_type;
+    bool rapid_commit = false;
+    switch (type) {
         case DHCPDISCOVER: {
-            int yi = DHCPS_MAX_IP;
-            for (int i = 0; i < DHCPS_MAX_IP; ++i) {
-                if (memcmp(d->lease[i].mac, dhcp_msg.chaddr, MAC_LEN) == 0) {
-                    // MAC match, use this IP address
-                    yi = i;
-                    break;
-                }
-                if (yi == DHCPS_MAX_IP) {
-                    // Look for a free IP address
-                    if (memcmp(d->lease[i].mac, "\x00\x00\x00\x00\x00\x00", MAC_LEN) == 0) {
-                        // IP available
-                        yi = i;
-                    }
-                    uint32_t expiry = d->lease[i].expiry << 16 | 0xffff;
-                    if ((int32_t)(expiry - cyw43_hal_ticks_ms()) < 0) {
-                        // IP expired, reuse it
-                        memset(d->lease[i].mac, 0, MAC_LEN);
-                        yi = i;
-                    }
-                }
+            // the client's lease, or the longest unused address
+            yi = lease_find(d, req->chaddr);
+            if (yi == DHCPS_NONE) {
+                yi = d->free_head;
             }
-            if (yi == DHCPS_MAX_IP) {
+            if (yi == DHCPS_NONE) {
                 // No more IP addresses left
                 goto ignore_request;
             }
-            dhcp_msg.yiaddr[3] = DHCPS_BASE_IP + yi;
-            opt_write_u8(&opt, DHCP_OPT_MSG_TYPE, DHCPOFFER);
+            #if DHCPS_RAPID_COMMIT
+            if (req_opt.rapid_commit) {
+                // Two message exchange: the address is bound right away
+                lease_set(d, yi, req->chaddr, LEASE_BOUND, DEFAULT_LEASE_TIME_S);
+                rapid_commit = true;
+                reply_type = DHCPACK;
+                break;
+            }
+            #endif
+            if (d->lease[yi].state != LEASE_BOUND) {
+                lease_set(d, yi, req->chaddr, LEASE_OFFERED, OFFER_TIME_S);
+            }
+            reply_type = DHCPOFFER;
             break;
         }
 
         case DHCPREQUEST: {
-            uint8_t *o = opt_find(opt, DHCP_OPT_REQUESTED_IP);
-            if (o == NULL) {
-                // Should be NACK
-                goto ignore_request;
-            }
-            if (memcmp(o + 2, &d->ip.addr, 3) != 0) {
-                // Should be NACK
+            const uint8_t *ip;
+            if (req_opt.requested_ip != NULL) {
+                // SELECTING or INIT-REBOOT
+                ip = req_opt.requested_ip;
+            } else if (memcmp(req->ciaddr, mac_none, 4) != 0) {
+                // RENEWING or REBINDING
+                ip = req->ciaddr;
+            } else {
                 goto ignore_request;
             }
-            uint8_t yi = o[5] - DHCPS_BASE_IP;
-            if (yi >= DHCPS_MAX_IP) {
-                // Should be NACK
+            if (req_opt.server_id != NULL && memcmp(req_opt.server_id, &d->ip.addr, 4) != 0) {
+                // The client took the offer of another server
+                yi = lease_find(d, req->chaddr);
+                if (yi != DHCPS_NONE && d->lease[yi].state == LEASE_OFFERED) {
+                    lease_release(d, yi);
+                }
                 goto ignore_request;
             }
-            if (memcmp(d->lease[yi].mac, dhcp_msg.chaddr, MAC_LEN) == 0) {
-                // MAC match, ok to use this IP address
-            } else if (memcmp(d->lease[yi].mac, "\x00\x00\x00\x00\x00\x00", MAC_LEN) == 0) {
-                // IP unused, ok to use this IP address
-                memcpy(d->lease[yi].mac, dhcp_msg.chaddr, MAC_LEN);
-            } else {
-                // IP already in use
-                // Should be NACK
-                goto ignore_request;
+            yi = lease_of(d, ip);
+            if (yi == DHCPS_NONE
+                || (d->lease[yi].state != LEASE_FREE && !lease_held(d, yi, req->chaddr))) {
+                // Address of another network, or already in use: a NAK
+                // makes the client start over at once, without timeouts
+                dhcp_log("NAK", req->chaddr, ip);
+                reply_type = DHCPNACK;
+                break;
             }
-            d->lease[yi].expiry = (cyw43_hal_ticks_ms() + DEFAULT_LEASE_TIME_S * 1000) >> 16;
-            dhcp_msg.yiaddr[3] = DHCPS_BASE_IP + yi;
-            opt_write_u8(&opt, DHCP_OPT_MSG_TYPE, DHCPACK);
-            DEBUG_printf("DHCPS: client connected: MAC=%02x:%02x:%02x:%02x:%02x:%02x IP=%u.%u.%u.%u\n",
-                dhcp_msg.chaddr[0], dhcp_msg.chaddr[1], dhcp_msg.chaddr[2], dhcp_msg.chaddr[3], dhcp_msg.chaddr[4], dhcp_msg.chaddr[5],
-                dhcp_msg.yiaddr[0], dhcp_msg.yiaddr[1], dhcp_msg.yiaddr[2], dhcp_msg.yiaddr[3]);
+            lease_set(d, yi, req->chaddr, LEASE_BOUND, DEFAULT_LEASE_TIME_S);
+            reply_type = DHCPACK;
             break;
         }
 
+        case DHCPDECLINE: {
+            // The client found that another host uses the address
+            if (req_opt.requested_ip != NULL) {
+                yi = lease_of(d, req_opt.requested_ip);
+                if (yi != DHCPS_NONE && lease_held(d, yi, req->chaddr)) {
+                    dhcp_log("address declined", req->chaddr, req_opt.requested_ip);
+                    lease_decline(d, yi);
+                }
+            }
+            goto ignore_request;
+        }
+
+        case DHCPRELEASE:
+            yi = lease_of(d, req->ciaddr);
+            if (yi != DHCPS_NONE && lease_held(d, yi, req->chaddr)) {
+                dhcp_log("client released", req->chaddr, req->ciaddr);
+                lease_release(d, yi);
+            }
+            goto ignore_request;
+
+        case DHCPINFORM:
+            // The client has an address, it only asks for the parameters
+            reply_type = DHCPACK;
+            break;
+
         default:
             goto ignore_request;
     }
 
-    opt_write_n(&opt, DHCP_OPT_SERVER_ID, 4, &d->ip.addr);
-    opt_write_n(&opt, DHCP_OPT_SUBNET_MASK, 4, &d->nm.addr);
-    opt_write_n(&opt, DHCP_OPT_ROUTER, 4, &d->ip.addr); // aka gateway; can have mulitple addresses
-    opt_write_u32(&opt, DHCP_OPT_DNS, DEFAULT_DNS); // can have mulitple addresses
-    opt_write_u32(&opt, DHCP_OPT_IP_LEASE_TIME, DEFAULT_LEASE_TIME_S);
-    *opt++ = DHCP_OPT_END;
-    dhcp_socket_sendto(&d->udp, &dhcp_msg, opt - (uint8_t *)&dhcp_msg, 0xffffffff, PORT_DHCP_CLIENT);
+    // Build the reply in the pbuf that is sent: the header up to chaddr
+    // is taken from the request, server name and boot file stay empty
+    reply = pbuf_alloc(PBUF_TRANSPORT, DHCP_REPLY_SIZE, PBUF_RAM);
+    if (reply == NULL) {
+        goto ignore_request;
+    }
+    dhcp_msg_t *msg = (dhcp_msg_t *)reply->payload;
+    memcpy(msg, req, offsetof(dhcp_msg_t, sname));
+    memset(msg->sname, 0, DHCP_OPTIONS_OFFSET - offsetof(dhcp_msg_t, sname));
+    msg->op = DHCPOFFER;
+    memset(msg->yiaddr, 0, 4);
+    if (reply_type == DHCPNACK) {
+        memset(msg->ciaddr, 0, 4);
+    } else if (type != DHCPINFORM) {
+        memcpy(&msg->yiaddr, &d->ip.addr, 4);
+        msg->yiaddr[3] = DHCPS_BASE_IP + yi;
+    }
+
+    uint8_t *opt = msg->options;
+    memcpy(opt, req->options, DHCP_MAGIC_COOKIE_LEN); // checked by dhcp_options_parse()
+    opt += DHCP_MAGIC_COOKIE_LEN;
+    opt_write_u8(&opt, DHCP_OPTION_MSG_TYPE, reply_type);
+    if (reply_type == DHCPNACK) {
+        opt_write_n(&opt, DHCP_OPTION_SERVER_ID, 4, &d->ip.addr);
+    } else {
+        if (rapid_commit) {
+            *opt++ = DHCP_OPTION_RAPID_COMMIT;
+            *opt++ = 0;
+        }
+        opt = opt_write_params(d, opt, &req_opt, type != DHCPINFORM);
+    }
+    *opt++ = DHCP_OPTION_END;
+    pbuf_realloc(reply, opt - (uint8_t *)msg);
+
+    // A client that has an address (RENEWING, INFORM) gets the reply by
+    // unicast, all others by broadcast
+    ip_addr_t dest;
+    if (reply_type != DHCPNACK && memcmp(msg->ciaddr, mac_none, 4) != 0 && memcmp(msg->giaddr, mac_none, 4) == 0) {
+        IP4_ADDR(&dest, msg->ciaddr[0], msg->ciaddr[1], msg->ciaddr[2], msg->ciaddr[3]);
+    } else {
+        IP4_ADDR(&dest, 255, 255, 255, 255);
+    }
+    udp_sendto(d->udp, reply, &dest, PORT_DHCP_CLIENT);
+
+    if ((type == DHCPREQUEST || rapid_commit) && reply_type == DHCPACK) {
+        dhcp_log(rapid_commit ? "client connected (rapid commit)" : "client connected", msg->chaddr, msg->yiaddr);
+    }
 
 ignore_request:
+    if (reply != NULL) {
+        pbuf_free(reply);
+    }
+    if (contiguous != NULL) {
+        pbuf_free(contiguous);
+    }
     pbuf_free(p);
+    dhcp_cycles_record(type, cycles);
+    TRACE_END(dhcp_trace, t);
 }
 
 void dhcp_server_init(dhcp_server_t *d, ip_addr_t *ip, ip_addr_t *nm) {
     ip_addr_copy(d->ip, *ip);
     ip_addr_copy(d->nm, *nm);
-    memset(d->lease, 0, sizeof(d->lease));
+    lease_init(d);
+    tmpl_init(d);
+    dhcp_cycles_start();
     if (dhcp_socket_new_dgram(&d->udp, d, dhcp_server_process) != 0) {
         return;
     }
@@ -300,4 +712,6 @@ void dhcp_server_init(dhcp_server_t *d, ip_addr_t *ip, ip_addr_t *nm) {
 
 void dhcp_server_deinit(dhcp_server_t *d) {
     dhcp_socket_free(&d->udp);
+    async_context_remove_at_time_worker(cyw43_arch_async_context(), &d->expiry_worker);
+    dhcp_cycles_print();
 }
@@ -26,20 +26,70 @@
 #ifndef MICROPY_INCLUDED_LIB_NETUTILS_DHCPSERVER_H
 #define MICROPY_INCLUDED_LIB_NETUTILS_DHCPSERVER_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "lwip/ip_addr.h"
+#include "pico/async_context.h"
 
+// The pool is x.x.x.DHCPS_BASE_IP ... x.x.x.(DHCPS_BASE_IP + DHCPS_MAX_IP - 1),
+// at most a full /24 (base 1, 254 addresses). The server's own address is
+// left out if it lies in the pool.
+#ifndef DHCPS_BASE_IP
 #define DHCPS_BASE_IP (16)
-#define DHCPS_MAX_IP (8)
+#endif
+#ifndef DHCPS_MAX_IP
+#define DHCPS_MAX_IP (32)
+#endif
+#if DHCPS_BASE_IP < 1 || DHCPS_MAX_IP < 1 || DHCPS_BASE_IP + DHCPS_MAX_IP > 255
+#error "the DHCP pool must lie within x.x.x.1 ... x.x.x.254"
+#endif
+
+// Buckets of the MAC index
+#define DHCPS_HASH_SIZE (DHCPS_MAX_IP <= 16 ? 16 : DHCPS_MAX_IP <= 64 ? 64 : 256)
+
+// Timer wheel: a lease is checked once per revolution, expired leases are
+// reclaimed at most one tick late. Slots * tick divides 2^32 ms, so the
+// slot of a lease does not change when the millisecond counter wraps.
+#define DHCPS_WHEEL_SLOTS (32)
+#define DHCPS_WHEEL_TICK_MS (2048)
+
+#define DHCPS_NONE (0xff) // end of a list of leases
+
+// Answer a DISCOVER with Rapid Commit (RFC 4039) by an ACK, if the client asks for it
+#ifndef DHCPS_RAPID_COMMIT
+#define DHCPS_RAPID_COMMIT (1)
+#endif
+
+// Parameters of the replies (server id, mask, router, DNS, lease time),
+// encoded once by dhcp_server_init(). All have a 4 byte value.
+#define DHCPS_TEMPLATE_OPTS (5)
+#define DHCPS_TEMPLATE_OPT_LEN (6)
 
 typedef struct _dhcp_server_lease_t {
     uint8_t mac[6];
-    uint16_t expiry;
+    uint8_t state;
+    uint8_t next; // hash bucket
+    uint8_t free_next; // free list
+    uint8_t free_prev;
+    uint8_t wheel_next; // timer wheel slot
+    uint8_t wheel_prev;
+    uint32_t expiry; // cyw43_hal_ticks_ms()
 } dhcp_server_lease_t;
 
 typedef struct _dhcp_server_t {
     ip_addr_t ip;
     ip_addr_t nm;
     dhcp_server_lease_t lease[DHCPS_MAX_IP];
+    uint8_t hash[DHCPS_HASH_SIZE]; // leases by MAC, including expired ones
+    uint8_t free_head; // unused leases, the longest unused first
+    uint8_t free_tail;
+    uint8_t wheel[DHCPS_WHEEL_SLOTS]; // offered, bound and declined leases by expiry
+    uint16_t wheel_count;
+    uint32_t wheel_time; // start of the next slot to check
+    bool expiry_scheduled;
+    async_at_time_worker_t expiry_worker;
+    uint8_t tmpl[DHCPS_TEMPLATE_OPTS][DHCPS_TEMPLATE_OPT_LEN];
     struct udp_pcb *udp;
 } dhcp_server_t;
 
@@ -19,27 +19,868 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <assert.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 
 #include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "pico/cyw43_arch.h"
 #include "hardware/flash.h"
-#include "hardware/sync.h"
 
 #include "access_point.h"
 #include "flash_program.h"
+#include "trace.h"
 
 // The next 2 lines are from the header files in pico-sdk
 // #define FLASH_SECTOR_SIZE (1u << 12) -> 4096 = 16 x 256
 // #define FLASH_PAGE_SIZE (1u << 8) -> 256
 
-// We use the last sector of flash to store the configuration.
+// We use the last FLASH_SECTORS sectors of flash to store the configuration.
 // Once done, we can access this at XIP_BASE + FLASH_TARGET_OFFSET.
-#define FLASH_TARGET_OFFSET ((PICO_FLASH_SIZE_BYTES) - FLASH_SECTOR_SIZE)
+#define FLASH_TARGET_OFFSET ((PICO_FLASH_SIZE_BYTES) - FLASH_SECTORS * FLASH_SECTOR_SIZE)
 #define FLASH_PAGES_PER_SECTOR (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
 const uint8_t *flash_target_contents = (const uint8_t *) (XIP_BASE + FLASH_TARGET_OFFSET);
 
+// End of the program in flash, the host build defines its own
+#ifndef FLASH_BINARY_END
+extern char __flash_binary_end;
+#define FLASH_BINARY_END ((uintptr_t)&__flash_binary_end)
+#endif
+
+// Older versions stored the pages unformatted in the last sector
+#define LEGACY_OFFSET ((PICO_FLASH_SIZE_BYTES) - FLASH_SECTOR_SIZE)
+
+/*
+ * The sectors are used as slots, holding a key-value store.
+ *
+ * A slot starts with the slot header, followed by an append-only log of
+ * records. The active slot is the one with a valid header and the highest
+ * generation. The slot following it (standby) is kept erased.
+ *
+ * Every call to kv_put() appends a record (header with key + data) at the
+ * first free (16 byte aligned) position of the active slot. The record with
+ * the highest sequence number for a key wins, older ones are simply ignored.
+ * kv_delete() clears the RECORD_VALID flag of that record.
+ *
+ * NOR flash can change bits from 1 to 0 without an erase. So appending to
+ * the erased part of a page, or clearing a flag, is done by programming the
+ * page again (see flash_update()). Records may share a page and an update
+ * never erases.
+ *
+ * When the active slot is full, the newest record of every key is copied
+ * to the standby slot and then its header is programmed. This flips the
+ * slots. A power loss before the header is written leaves the old slot
+ * active. The next slot is erased later by flash_prepare_standby(), at
+ * boot, by a worker shortly after the flip, or when idle, so that the next
+ * flip does not need an erase either.
+ * The slots are used round-robin, so every sector is erased equally often.
+ *
+ * Every erase is followed by programming a header, which holds nothing
+ * but the number of erases of this sector. The rest of the header is
+ * programmed when the slot becomes active. A power loss between the erase
+ * and the header loses the count of this sector.
+ *
+ * The log is read once, when the active slot is selected. It builds an
+ * index in RAM: a hash table holding the position of the newest record
+ * of every key and the position where the next record goes.
+ *
+ * The page functions (flash_write_page() etc.) are kept for existing
+ * callers, page n is stored with the key "page<n>".
+ *
+ * A sector written by an older version of this software (raw pages, no
+ * headers) is imported into the log by flash_init(). Page 0 becomes
+ * the Wi-Fi configuration. The last sector is the last slot, so it is
+ * not touched before all other slots have been used.
+ */
+#define SLOT_MAGIC      0x544F4C53  // "SLOT"
+
+typedef struct _flash_slot_header {
+    uint32_t magic;
+    uint32_t generation;    // higher is newer
+    uint32_t check;         // ~generation
+    uint32_t erase_count;   // 0xFFFFFFFF: unknown
+} flash_slot_header;
+
+#define RECORD_MAGIC    0x4B56      // "VK"
+#define RECORD_FREE     0xFFFFFFFF  // seq of an unused (erased) header
+#define RECORD_VALID    0x01        // flag, cleared when the key is deleted
+
+typedef struct _flash_record {
+    uint16_t magic;
+    uint8_t  flags;     // not covered by crc, see RECORD_VALID
+    uint8_t  reserved;  // 0xFF
+    uint16_t len;       // length of data
+    uint16_t reserved2; // 0xFFFF
+    uint32_t seq;       // sequence number, higher is newer
+    uint32_t crc;       // over header (except flags and crc) and data
+    char     key[KV_KEY_MAX + 1];   // zero padded
+} flash_record;
+
+#define RECORD_ALIGN    16
+#define RECORD_SIZE(len) \
+    ((sizeof(flash_record) + (len) + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1))
+#define LOG_START       sizeof(flash_slot_header)
+#define RECORD_MAX_LEN  (FLASH_SECTOR_SIZE - LOG_START - sizeof(flash_record))
+
+// kv_get() hands out pointers to the data of a record
+static_assert(sizeof(flash_record) % FLASH_VIEW_ALIGN == 0, "record data misaligned");
+static_assert(LOG_START % RECORD_ALIGN == 0 && RECORD_ALIGN % FLASH_VIEW_ALIGN == 0,
+              "record misaligned");
+static_assert(RECORD_MAX_LEN == FLASH_RECORD_MAX_LEN, "FLASH_RECORD_MAX_LEN is wrong");
+
+/*
+ * The index
+ * Open addressing, the table is twice as large as the number of keys.
+ * An entry holds the offset of the newest record in the active slot,
+ * 0 if it is unused.
+ */
+#define INDEX_SIZE      (2 * KV_MAX_KEYS)
+static_assert((INDEX_SIZE & (INDEX_SIZE - 1)) == 0, "KV_MAX_KEYS must be a power of 2");
+
+typedef struct _index_entry {
+    uint16_t offset;
+    uint16_t hash;      // upper bits of the hash, to avoid most key compares
+} index_entry;
+
+static index_entry index_table[INDEX_SIZE];
+static int     index_keys;          // used entries
+static size_t  log_end;             // first free offset in the active slot
+static uint32_t log_seq;            // highest sequence number in use
+
+// A contiguous part of the data written by flash_update()
+typedef struct _flash_segment {
+    const void *data;
+    size_t      len;
+} flash_segment;
+
+static_assert(FLASH_SECTORS >= 2, "FLASH_SECTORS must be 2 or more");
+
+static int active_slot = -1;        // not yet selected
+static bool standby_erased;
+static flash_stats stats;
+
+// No malloc: pages are merged here before they are programmed
+static uint8_t page_buf[FLASH_PAGE_SIZE];
+
+/*
+ * Asynchronous commits (flash_commit_async()) are done by a worker of the
+ * cyw43 async context. All other calls hold the lock of this context
+ * meanwhile, so that they do not interfere with the worker.
+ */
+static inline void flash_lock()
+{
+    async_context_t *context = cyw43_arch_async_context();
+    if(context)
+        async_context_acquire_lock_blocking(context);
+}
+
+static inline void flash_unlock()
+{
+    async_context_t *context = cyw43_arch_async_context();
+    if(context)
+        async_context_release_lock(context);
+}
+
+static uint32_t crc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+    crc = ~crc;
+    while(len--){
+        crc ^= *data++;
+        for(int i = 0; i < 8; i++)
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+    return ~crc;
+}
+
+static uint32_t record_crc(const flash_record *r, const void *data)
+{
+    flash_record h = *r;
+    h.flags = 0xFF;
+    h.crc = 0xFFFFFFFF;
+    uint32_t crc = crc32(0, (const uint8_t *)&h, sizeof(h));
+    return crc32(crc, (const uint8_t *)data, r->len);
+}
+
+// FNV-1a
+static uint32_t key_hash(const char *key)
+{
+    uint32_t hash = 2166136261u;
+    for(int i = 0; i <= KV_KEY_MAX && key[i]; i++)
+        hash = (hash ^ (uint8_t)key[i]) * 16777619u;
+    return hash;
+}
+
+static inline uint32_t slot_offset(int slot)
+{
+    return FLASH_TARGET_OFFSET + slot * FLASH_SECTOR_SIZE;
+}
+
+static inline const uint8_t *slot_base(int slot)
+{
+    return flash_target_contents + slot * FLASH_SECTOR_SIZE;
+}
+
+// The slot that will be used when the active one is full
+static inline int standby_slot()
+{
+    return (active_slot + 1) % FLASH_SECTORS;
+}
+
+static inline const flash_record *record_at(uint16_t offset)
+{
+    return (const flash_record *)(slot_base(active_slot) + offset);
+}
+
+static bool range_is_blank(const uint8_t *p, size_t len)
+{
+    const uint32_t *w = (const uint32_t *)p;
+    for(size_t i = 0; i < len / sizeof(uint32_t); i++){
+        if(w[i] != 0xFFFFFFFF)
+            return false;
+    }
+    return true;
+}
+
+// Returns the generation of a valid slot header, 0 otherwise
+static uint32_t slot_generation(int slot)
+{
+    const flash_slot_header *h = (const flash_slot_header *)slot_base(slot);
+    if(h->magic != SLOT_MAGIC || h->check != ~h->generation)
+        return 0;
+    return h->generation;
+}
+
+static uint32_t slot_erase_count(int slot)
+{
+    const flash_slot_header *h = (const flash_slot_header *)slot_base(slot);
+    return h->erase_count != 0xFFFFFFFF ? h->erase_count : 0;
+}
+
+// True if nothing but the erase count has been written to "slot"
+static bool slot_is_blank(int slot)
+{
+    const flash_slot_header *h = (const flash_slot_header *)slot_base(slot);
+    return h->magic == 0xFFFFFFFF && h->generation == 0xFFFFFFFF && h->check == 0xFFFFFFFF &&
+           range_is_blank(slot_base(slot) + LOG_START, FLASH_SECTOR_SIZE - LOG_START);
+}
+
+/*
+ * All erase and program operations go through flash_safe_execute(), which
+ * disables interrupts on this core and, if the other core is running,
+ * locks it out, as no code may run from flash meanwhile.
+ * Interrupts are only disabled for a single erase or page program.
+ */
+#define FLASH_SAFE_TIMEOUT_MS 100
+
+typedef struct _flash_op {
+    uint32_t       offset;
+    const uint8_t *data;    // NULL: erase a sector
+} flash_op;
+
+static void flash_op_execute(void *param)
+{
+    const flash_op *op = (const flash_op *)param;
+    if(op->data)
+        flash_range_program(op->offset, op->data, FLASH_PAGE_SIZE);
+    else
+        flash_range_erase(op->offset, FLASH_SECTOR_SIZE);
+}
+
+// An erase takes about 45 ms, much longer ones mean a worn out sector
+#ifndef FLASH_ERASE_BUDGET_US
+#define FLASH_ERASE_BUDGET_US 100000
+#endif
+
+TRACE_SITE_BUDGET(erase_trace, "flash erase", FLASH_ERASE_BUDGET_US);
+TRACE_SITE(program_trace, "flash program");
+
+static bool flash_do(uint32_t offset, const uint8_t *data)
+{
+    flash_op op = { offset, data };
+    uint32_t t = TRACE_BEGIN();
+    int rc = flash_safe_execute(flash_op_execute, &op, FLASH_SAFE_TIMEOUT_MS);
+    if(data)
+        TRACE_END(program_trace, t);
+    else
+        TRACE_END(erase_trace, t);
+    if(rc != PICO_OK){
+        DEBUG_printf("flash_safe_execute failed: %d\n", rc);
+        return false;
+    }
+    return true;
+}
+
+// Erases "slot" and programs its header with the new erase count
+static bool flash_do_erase(int slot)
+{
+    uint32_t count = slot_erase_count(slot) + 1;
+
+    if(!flash_do(slot_offset(slot), NULL))
+        return false;
+    stats.erases++;
+
+    memset(page_buf, 0xFF, FLASH_PAGE_SIZE);
+    ((flash_slot_header *)page_buf)->erase_count = count;
+    if(!flash_do(slot_offset(slot), page_buf))
+        return false;
+    stats.bytes_programmed += FLASH_PAGE_SIZE;
+    return true;
+}
+
+/*
+ * flash_update()
+ *
+ * Writes the segments "seg" one after the other, starting at "offset"
+ * (relative to the start of the flash), comparing them to the current
+ * contents first:
+ * - identical:                nothing is written    FLASH_WRITE_SKIPPED
+ * - only bits to be cleared:  programmed in place   FLASH_WRITE_PROGRAMMED
+ * - any bit to be set:        nothing is written    FLASH_WRITE_NEEDS_ERASE
+ * Only the pages that change are programmed, the rest of these pages
+ * keeps its contents. The data may point into the XIP mapped flash itself.
+ */
+static flash_write_result flash_update(uint32_t offset, const flash_segment *seg, int nseg)
+{
+    uint32_t end = offset;
+    bool same = true;
+
+    for(int s = 0; s < nseg; s++){
+        const uint8_t *cur = (const uint8_t *)(XIP_BASE + end);
+        const uint8_t *data = (const uint8_t *)seg[s].data;
+        for(size_t i = 0; i < seg[s].len; i++){
+            if(cur[i] == data[i])
+                continue;
+            if((cur[i] & data[i]) != data[i])
+                return FLASH_WRITE_NEEDS_ERASE;
+            same = false;
+        }
+        end += seg[s].len;
+    }
+    if(same)
+        return FLASH_WRITE_SKIPPED;
+
+    for(uint32_t page = offset & ~(FLASH_PAGE_SIZE - 1); page < end; page += FLASH_PAGE_SIZE){
+        const uint8_t *xip = (const uint8_t *)(XIP_BASE + page);
+
+        // The flash can not be read while it is programmed,
+        // so the page is merged in RAM first
+        memcpy(page_buf, xip, FLASH_PAGE_SIZE);
+        uint32_t pos = offset;
+        for(int s = 0; s < nseg; pos += seg[s++].len){
+            uint32_t from = pos > page ? pos : page;
+            uint32_t to = pos + seg[s].len;
+            if(to > page + FLASH_PAGE_SIZE)
+                to = page + FLASH_PAGE_SIZE;
+            if(from < to)
+                memcpy(page_buf + (from - page), (const uint8_t *)seg[s].data + (from - pos), to - from);
+        }
+        if(memcmp(page_buf, xip, FLASH_PAGE_SIZE) == 0)
+            continue;
+
+        if(!flash_do(page, page_buf))
+            return FLASH_WRITE_FAILED;
+        stats.bytes_programmed += FLASH_PAGE_SIZE;
+    }
+    return FLASH_WRITE_PROGRAMMED;
+}
+
+/*
+ * Returns the index entry of "key": the one in use, or the free one
+ * where it has to be added. NULL if the key is not there and the
+ * index is full.
+ */
+static index_entry *index_lookup(const char *key)
+{
+    uint32_t hash = key_hash(key);
+    uint16_t tag = hash >> 16;
+
+    for(int n = 0, i = hash & (INDEX_SIZE - 1); n < INDEX_SIZE; n++, i = (i + 1) & (INDEX_SIZE - 1)){
+        index_entry *e = &index_table[i];
+        if(!e->offset)
+            return index_keys < KV_MAX_KEYS ? e : NULL;
+        if(e->hash == tag && strncmp(record_at(e->offset)->key, key, KV_KEY_MAX + 1) == 0)
+            return e;
+    }
+    return NULL;
+}
+
+// Makes the record at "offset" the newest one of its key
+static bool index_add(uint16_t offset)
+{
+    const flash_record *r = record_at(offset);
+    index_entry *e = index_lookup(r->key);
+
+    if(!e)
+        return false;
+    if(!e->offset){
+        e->hash = key_hash(r->key) >> 16;
+        index_keys++;
+    }
+    else if(record_at(e->offset)->seq > r->seq)
+        return true;
+    e->offset = offset;
+    return true;
+}
+
+/*
+ * Reads the log of the active slot once and builds the index.
+ * Records with a wrong crc (interrupted writes) are skipped.
+ */
+static void index_build()
+{
+    const uint8_t *base = slot_base(active_slot);
+    size_t o = LOG_START;
+
+    memset(index_table, 0, sizeof(index_table));
+    index_keys = 0;
+    log_seq = 0;
+
+    while(o + sizeof(flash_record) <= FLASH_SECTOR_SIZE){
+        const flash_record *r = (const flash_record *)(base + o);
+        if(r->magic != RECORD_MAGIC){
+            if(range_is_blank((const uint8_t *)r, sizeof(flash_record)))
+                break;
+            o += RECORD_ALIGN;  // garbage, probably an interrupted write
+            continue;
+        }
+        if(r->len > FLASH_SECTOR_SIZE - o - sizeof(flash_record) || r->seq == RECORD_FREE){
+            o += RECORD_ALIGN;
+            continue;
+        }
+        if(record_crc(r, r + 1) == r->crc){
+            if(r->seq > log_seq)
+                log_seq = r->seq;
+            if(!index_add(o))
+                DEBUG_printf("flash index full, key \"%.*s\" ignored\n", KV_KEY_MAX, r->key);
+        }
+        o += RECORD_SIZE(r->len);
+    }
+    log_end = o < FLASH_SECTOR_SIZE ? o : FLASH_SECTOR_SIZE;
+}
+
+// Returns the newest record of "key", NULL if there is none or it is deleted
+static const flash_record *log_find(const char *key)
+{
+    index_entry *e = index_lookup(key);
+    if(!e || !e->offset)
+        return NULL;
+
+    const flash_record *r = record_at(e->offset);
+    return (r->flags & RECORD_VALID) ? r : NULL;
+}
+
+// Programs the header of "slot" with "generation", which makes it the active slot
+static bool slot_activate(int slot, uint32_t generation)
+{
+    flash_slot_header h;
+    flash_segment seg = { &h, sizeof(h) };
+
+    h = *(const flash_slot_header *)slot_base(slot);  // keeps the erase count
+    h.magic = SLOT_MAGIC;
+    h.generation = generation;
+    h.check = ~generation;
+    standby_erased = false;
+    if(flash_update(slot_offset(slot), &seg, 1) != FLASH_WRITE_PROGRAMMED)
+        return false;
+
+    active_slot = slot;
+    index_build();
+    return true;
+}
+
+/*
+ * Copies the newest record of every key (deleted ones are dropped)
+ * to the standby slot and makes it the active slot.
+ */
+static flash_write_result log_compact()
+{
+    flash_write_result result = FLASH_WRITE_FLIPPED;
+    int from = active_slot;
+    int to = standby_slot();
+    size_t used = LOG_START;
+
+    if(!standby_erased){
+        // flash_prepare_standby() has not been called since the last flip
+        if(!flash_do_erase(to))
+            goto failed;
+        stats.inline_erases++;
+        result = FLASH_WRITE_ERASED;
+    }
+
+    for(int i = 0; i < INDEX_SIZE; i++){
+        if(!index_table[i].offset)
+            continue;
+        const flash_record *r = record_at(index_table[i].offset);
+        if(!(r->flags & RECORD_VALID))
+            continue;
+        flash_segment seg = { r, sizeof(flash_record) + r->len };
+        if(flash_update(slot_offset(to) + used, &seg, 1) != FLASH_WRITE_PROGRAMMED)
+            goto failed;
+        used += RECORD_SIZE(r->len);
+    }
+
+    if(!slot_activate(to, slot_generation(from) + 1))
+        goto failed;
+    stats.compactions++;
+    return result;
+
+failed:
+    // the old slot is still active
+    standby_erased = false;
+    return FLASH_WRITE_FAILED;
+}
+
+/*
+ * Appends a record for "key".
+ * The slots are flipped, if there is not enough room left.
+ */
+static flash_write_result log_append(const char *key, const void *data, uint16_t len)
+{
+    flash_write_result result = FLASH_WRITE_PROGRAMMED;
+
+    if(len > RECORD_MAX_LEN){
+        DEBUG_printf("flash record too large (%d bytes)\n", len);
+        return FLASH_WRITE_FAILED;
+    }
+    if(!index_lookup(key)){
+        DEBUG_printf("flash index full, can not add \"%s\"\n", key);
+        return FLASH_WRITE_FAILED;
+    }
+
+    if(log_end + sizeof(flash_record) + len > FLASH_SECTOR_SIZE){
+        result = log_compact();
+        if(result == FLASH_WRITE_FAILED)
+            return result;
+    }
+    if(log_end + sizeof(flash_record) + len > FLASH_SECTOR_SIZE){
+        DEBUG_printf("no room in flash for \"%s\"\n", key);
+        return FLASH_WRITE_FAILED;
+    }
+
+    // The data is programmed straight from the callers buffer
+    flash_record r;
+    memset(&r, 0, sizeof(r));
+    r.magic = RECORD_MAGIC;
+    r.flags = 0xFF;
+    r.reserved = 0xFF;
+    r.len   = len;
+    r.reserved2 = 0xFFFF;
+    r.seq   = log_seq + 1;
+    strncpy(r.key, key, KV_KEY_MAX);
+    r.crc   = record_crc(&r, data);
+
+    flash_segment seg[] = { { &r, sizeof(r) }, { data, len } };
+    switch(flash_update(slot_offset(active_slot) + log_end, seg, 2)){
+        case FLASH_WRITE_NEEDS_ERASE:
+            // Should not happen, the free space is erased
+            DEBUG_printf("flash not erased at %d\n", (int)log_end);
+            return FLASH_WRITE_FAILED;
+        case FLASH_WRITE_FAILED:
+            return FLASH_WRITE_FAILED;
+        default:
+            break;
+    }
+
+    log_seq = r.seq;
+    index_add(log_end);
+    log_end += RECORD_SIZE(len);
+    stats.writes++;
+    return result;
+}
+
+/*
+ * Imports the pages of the unformatted layout of older versions
+ * into the (empty) log. Each non-blank page becomes a record of
+ * FLASH_PAGE_SIZE bytes, as long as they fit into the slot.
+ * The legacy sector is also the last slot, which is not touched
+ * before the slots are flipped.
+ */
+static void page_key(size_t page, char *key);
+
+static void legacy_import()
+{
+    const uint8_t *legacy = (const uint8_t *)(XIP_BASE + LEGACY_OFFSET);
+    char key[KV_KEY_MAX + 1];
+
+    for(size_t page = 0; page < FLASH_PAGES_PER_SECTOR; page++){
+        const uint8_t *data = legacy + page * FLASH_PAGE_SIZE;
+        if(range_is_blank(data, FLASH_PAGE_SIZE))
+            continue;
+        if(log_end + sizeof(flash_record) + FLASH_PAGE_SIZE > FLASH_SECTOR_SIZE)
+            break;
+        if(page == 0)
+            strcpy(key, WIFI_CONFIG_KEY);
+        else
+            page_key(page, key);
+        log_append(key, data, FLASH_PAGE_SIZE);
+        DEBUG_printf("Imported page %d of an older version\n", (int)page);
+    }
+}
+
+/*
+ * Selects the active slot and builds the index.
+ * Only the slot headers and the log of the active slot are read.
+ * If there is no valid slot, slot 0 is formatted.
+ */
+static void slot_select()
+{
+    if(active_slot >= 0)
+        return;
+
+    uint32_t newest = 0;
+    for(int slot = 0; slot < FLASH_SECTORS; slot++){
+        uint32_t gen = slot_generation(slot);
+        if(gen > newest){
+            newest = gen;
+            active_slot = slot;
+        }
+    }
+
+    if(newest){
+        standby_erased = slot_is_blank(standby_slot());
+        index_build();
+        return;
+    }
+
+    if(!slot_is_blank(0))
+        flash_do_erase(0);
+    if(!slot_activate(0, 1)){
+        printf("ERROR: can not format the configuration flash\n");
+        active_slot = 0;    // reads will find no records
+        index_build();
+        return;
+    }
+    legacy_import();
+}
+
+/*
+ * flash_init()
+ *
+ * Selects the active slot and erases the standby slot, so that
+ * no later write needs to erase.
+ * Halts if the program reaches into the configuration sectors,
+ * an erase would destroy its code.
+ */
+void flash_init()
+{
+    if(FLASH_BINARY_END - XIP_BASE > FLASH_TARGET_OFFSET)
+        panic("ERROR: program overlaps the configuration in flash, reduce FLASH_SECTORS\n");
+
+    flash_lock();
+    slot_select();
+    flash_prepare_standby();
+    flash_unlock();
+}
+
+/*
+ * flash_prepare_standby()
+ *
+ * Erases the standby slot, if this has not yet been done.
+ * Call this at boot or when idle, not from time critical code.
+ * Returns true if an erase was necessary.
+ */
+bool flash_prepare_standby()
+{
+    bool dirty = false;
+
+    flash_lock();
+    slot_select();
+    if(!standby_erased){
+        int standby = standby_slot();
+        dirty = !slot_is_blank(standby);
+        if(!dirty || flash_do_erase(standby))
+            standby_erased = true;
+    }
+    flash_unlock();
+    return dirty;
+}
+
+/*
+ * After a flip the new standby slot is erased FLASH_STANDBY_DELAY_MS
+ * later by a worker of the cyw43 async context, so that the next flip
+ * does not need to erase inline. Without an async context this is
+ * left to flash_prepare_standby().
+ */
+#define FLASH_STANDBY_DELAY_MS 1000
+
+static void standby_work(async_context_t *context, async_at_time_worker_t *worker)
+{
+    flash_prepare_standby();
+}
+
+static async_at_time_worker_t standby_worker = { .do_work = standby_work };
+
+// The lock must be held
+static void standby_schedule()
+{
+    async_context_t *context = cyw43_arch_async_context();
+
+    if(!context || standby_erased)
+        return;
+    async_context_remove_at_time_worker(context, &standby_worker);
+    async_context_add_at_time_worker_in_ms(context, &standby_worker, FLASH_STANDBY_DELAY_MS);
+}
+
+/*
+ * kv_put()
+ *
+ * Stores "len" bytes of "data" under "key" (at most KV_KEY_MAX characters).
+ * Returns how this was done, FLASH_WRITE_SKIPPED if the data is unchanged.
+ */
+flash_write_result kv_put(const char *key, const void *data, uint16_t len)
+{
+    flash_write_result result;
+
+    if(strlen(key) > KV_KEY_MAX){
+        DEBUG_printf("key too long: \"%s\"\n", key);
+        return FLASH_WRITE_FAILED;
+    }
+
+    flash_lock();
+    slot_select();
+
+    const flash_record *r = log_find(key);
+    if(r && r->len == len && memcmp(r + 1, data, len) == 0){
+        stats.skipped++;
+        result = FLASH_WRITE_SKIPPED;
+    }
+    else
+        result = log_append(key, data, len);
+    if(result == FLASH_WRITE_FLIPPED || result == FLASH_WRITE_ERASED)
+        standby_schedule();
+
+    flash_unlock();
+    return result;
+}
+
+/*
+ * kv_get()
+ *
+ * Returns a pointer to the data stored under "key" in the XIP mapped
+ * flash (aligned to FLASH_VIEW_ALIGN) and its length in "len".
+ * NULL and 0 if there is none.
+ * The pointer is valid until the next write or delete.
+ */
+const void *kv_get(const char *key, uint16_t *len)
+{
+    flash_lock();
+    slot_select();
+
+    const flash_record *r = log_find(key);
+    flash_unlock();
+
+    *len = r ? r->len : 0;
+    return r ? (const void *)(r + 1) : NULL;
+}
+
+/*
+ * kv_delete()
+ *
+ * Deletes "key". Only a flag of its record is cleared, no erase is needed.
+ */
+flash_write_result kv_delete(const char *key)
+{
+    flash_write_result result = FLASH_WRITE_SKIPPED;
+
+    flash_lock();
+    slot_select();
+
+    const flash_record *r = log_find(key);
+    if(r){
+        flash_record h = *r;
+        flash_segment seg = { &h, sizeof(h) };
+        h.flags &= ~RECORD_VALID;
+        result = flash_update((uintptr_t)r - XIP_BASE, &seg, 1);
+    }
+
+    flash_unlock();
+    return result;
+}
+
+/*
+ * flash_commit_async()
+ *
+ * Stores "len" bytes of "data" under "key" like kv_put(), or deletes
+ * the key if "data" is NULL, without blocking the caller.
+ * The write is done by a worker in the context of the lwIP callbacks,
+ * where "callback" is called, once the data is in flash.
+ * "data" must stay valid until then, it is read when it is written, so
+ * changes made meanwhile (with the lock held) are written as well.
+ * Up to FLASH_COMMIT_MAX keys can be pending. A further commit of a
+ * pending key replaces the pending one (its callback is not called).
+ * Returns false if there is no async context or no free entry, use
+ * kv_put() then.
+ */
+static struct _flash_commit {
+    bool            pending;
+    char            key[KV_KEY_MAX + 1];
+    const void     *data;
+    uint16_t        len;
+    flash_commit_cb callback;
+    void           *arg;
+} commits[FLASH_COMMIT_MAX];
+
+static async_when_pending_worker_t commit_worker;
+static bool commit_worker_added;
+
+static void commit_work(async_context_t *context, async_when_pending_worker_t *worker)
+{
+    flash_write_result result;
+
+    for(int i = 0; i < FLASH_COMMIT_MAX; i++){
+        struct _flash_commit c = commits[i];
+        if(!c.pending)
+            continue;
+        // the callback may commit again
+        commits[i].pending = false;
+        if(c.data)
+            result = kv_put(c.key, c.data, c.len);
+        else
+            result = kv_delete(c.key);
+        if(c.callback)
+            c.callback(result, c.arg);
+    }
+}
+
+bool flash_commit_async(const char *key, const void *data, uint16_t len,
+                        flash_commit_cb callback, void *arg)
+{
+    async_context_t *context = cyw43_arch_async_context();
+    struct _flash_commit *c = NULL;
+
+    if(!context)
+        return false;   // cyw43_arch_init() has not been called
+    if(strlen(key) > KV_KEY_MAX)
+        return false;
+
+    async_context_acquire_lock_blocking(context);
+    if(!commit_worker_added){
+        commit_worker.do_work = commit_work;
+        async_context_add_when_pending_worker(context, &commit_worker);
+        commit_worker_added = true;
+    }
+    for(int i = 0; i < FLASH_COMMIT_MAX; i++){
+        if(commits[i].pending && strcmp(commits[i].key, key) == 0){
+            c = &commits[i];
+            break;
+        }
+        if(!commits[i].pending && !c)
+            c = &commits[i];
+    }
+    if(c){
+        strcpy(c->key, key);
+        c->data = data;
+        c->len = len;
+        c->callback = callback;
+        c->arg = arg;
+        c->pending = true;
+        async_context_set_work_pending(context, &commit_worker);
+    }
+    async_context_release_lock(context);
+    return c != NULL;
+}
+
 void show_stats()
 {
     printf("Statistics:\n");
@@ -48,69 +889,146 @@ void show_stats()
            PICO_FLASH_SIZE_BYTES / FLASH_SECTOR_SIZE,
            FLASH_SECTOR_SIZE / 1024);
 
-    extern char __flash_binary_end;
-    uintptr_t program_end = ((uintptr_t)&__flash_binary_end - XIP_BASE);
+    uintptr_t program_end = FLASH_BINARY_END - XIP_BASE;
     uint16_t progsizekB = (program_end / 1024) +
                 (program_end % 1024 ? 1 : 0);
     uint16_t progsizeSec = (program_end / FLASH_SECTOR_SIZE) +
                 (program_end % FLASH_SECTOR_SIZE ? 1 : 0);
 
-                printf("\tUsed by this programm: %d kB, %d Sectors (@ %d kB)\n\n",
+                printf("\tUsed by this programm: %d kB, %d Sectors (@ %d kB)\n",
                        progsizekB, progsizeSec, FLASH_SECTOR_SIZE / 1024);
+
+    uint32_t counts[FLASH_SECTORS];
+    flash_erase_counts(counts, FLASH_SECTORS);
+    printf("\tConfiguration: %d Sectors, erases:", FLASH_SECTORS);
+    for(int i = 0; i < FLASH_SECTORS; i++)
+        printf(" %lu", (unsigned long)counts[i]);
+    printf("\n\n");
 }
 
-void flash_erase_page(size_t pageStart, size_t numPages)
+/*
+ * The page functions of older versions
+ */
+static void page_key(size_t page, char *key)
 {
-    uint8_t *buf;
-
-    // We can only erase a whole sector, which has 16 pages
-    // So we read the sector (all 16 pages) first and save it
-    buf = (uint8_t *)malloc(FLASH_SECTOR_SIZE);
-    if(!buf)
-        DEBUG_printf("malloc failed\n");
-    memcpy(buf, flash_target_contents, FLASH_SECTOR_SIZE);
+    snprintf(key, KV_KEY_MAX + 1, "page%u", (unsigned)page);
+}
 
-    uint32_t interrupts = save_and_disable_interrupts();        // now we erase the sector
-    flash_range_erase(FLASH_TARGET_OFFSET, FLASH_SECTOR_SIZE);
+// Marks "numPages" pages, starting at "pageStart" as erased.
+// Reading an erased page returns 0xFF, as it did with the real flash.
+flash_write_result flash_erase_page(size_t pageStart, size_t numPages)
+{
+    flash_write_result result = FLASH_WRITE_SKIPPED;
+    char key[KV_KEY_MAX + 1];
 
-    //next set numPages, starting at pageStart to 0xFF
-    for(int i = 0; i < (numPages * FLASH_PAGE_SIZE); i++){
-        buf[(pageStart * FLASH_PAGE_SIZE) + i] = 0xFF;
+    for(size_t page = pageStart; page < pageStart + numPages; page++){
+        page_key(page, key);
+        flash_write_result r = kv_delete(key);
+        if(r != FLASH_WRITE_SKIPPED)
+            result = r;
+        if(r == FLASH_WRITE_FAILED)
+            break;
     }
-
-    //and write it back to the flash
-    flash_range_program(FLASH_TARGET_OFFSET, buf, FLASH_SECTOR_SIZE);
-    restore_interrupts(interrupts);
-
-    free(buf);
+    return result;
 }
 
-// Writes "data" to flash, starting at "pageStart"
-// Flash after the end of "data" up to the end of the page is set to 0XFF
-void flash_write_page(uint8_t *data, uint16_t buf_len, size_t pageStart)
+// Writes "data" to flash as the new content of "pageStart"
+// Reading beyond the end of "data" returns 0xFF
+flash_write_result flash_write_page(const uint8_t *data, uint16_t buf_len, size_t pageStart)
 {
-    uint8_t *buf;
-    uint8_t numPages;
-
-    numPages = (buf_len / FLASH_PAGE_SIZE) + (buf_len % FLASH_PAGE_SIZE ? 1 : 0);
+    char key[KV_KEY_MAX + 1];
 
+    page_key(pageStart, key);
+    return kv_put(key, data, buf_len);
+}
 
-    buf = (uint8_t *)malloc(FLASH_PAGE_SIZE * numPages);
-    memset(buf, 0XFF, (FLASH_PAGE_SIZE * numPages));
-    memcpy((void *)buf, data, buf_len);
+void flash_read(uint8_t *data,uint16_t len, size_t pageStart)
+{
+    char key[KV_KEY_MAX + 1];
+    uint16_t n;
 
-    flash_erase_page(pageStart, numPages);
+    page_key(pageStart, key);
+    const uint8_t *p = kv_get(key, &n);
+    if(n > len)
+        n = len;
+    if(n)
+        memcpy((void *)data, p, n);
+    memset(data + n, 0xFF, len - n);
+}
 
-    uint32_t interrupts = save_and_disable_interrupts();        flash_range_program(FLASH_TARGET_OFFSET + (FLASH_PAGE_SIZE * pageStart),
-                        buf, FLASH_PAGE_SIZE * numPages);
-    restore_interrupts(interrupts);
-    free(buf);
+void flash_get_stats(flash_stats *s)
+{
+    *s = stats;
 }
 
-void flash_read(uint8_t *data,uint16_t len, size_t pageStart)
+/*
+ * flash_erase_counts()
+ *
+ * Copies the number of erases of each sector of the storage region,
+ * starting with the lowest address, to "counts" (at most "max").
+ * Returns the number of sectors, FLASH_SECTORS.
+ */
+int flash_erase_counts(uint32_t *counts, int max)
 {
-    memcpy((void *)data,
-           flash_target_contents + (FLASH_PAGE_SIZE * pageStart),
-           len);
+    for(int slot = 0; slot < FLASH_SECTORS && slot < max; slot++)
+        counts[slot] = slot_erase_count(slot);
+    return FLASH_SECTORS;
 }
 
+/*
+ * flash_benchmark()
+ *
+ * Writes "updates" different records of the size of the configuration
+ * under a scratch key and prints the number of erases and programmed bytes
+ * per update, and which path the writes took.
+ * The standby slot is prepared after every update, as an idle loop would.
+ * Erases done while writing (inline) are counted separately.
+ * The old implementation erased the sector and programmed it completely
+ * (4096 bytes) plus the page itself on every update.
+ */
+#define BENCHMARK_KEY "bench"
+
+void flash_benchmark(int updates)
+{
+    static const char *names[] = {
+        "skipped", "programmed", "flipped", "erased", "needs erase", "failed"
+    };
+    #define NUM_PATHS (sizeof(names) / sizeof(names[0]))
+    uint32_t paths[NUM_PATHS] = { 0 };
+    uint8_t data[sizeof(config)];
+    flash_stats start, end;
+
+    if(updates <= 0)
+        return;
+
+    memset(data, 0x55, sizeof(data));
+    flash_get_stats(&start);
+    for(int i = 0; i < updates; i++){
+        // every 4th update repeats the previous data
+        if(i % 4 != 3)
+            memcpy(data, &i, sizeof(i));
+        paths[kv_put(BENCHMARK_KEY, data, sizeof(data))]++;
+        flash_prepare_standby();
+    }
+    flash_get_stats(&end);
+    kv_delete(BENCHMARK_KEY);
+
+    uint32_t erases = end.erases - start.erases;
+    uint32_t inline_erases = end.inline_erases - start.inline_erases;
+    uint32_t bytes  = end.bytes_programmed - start.bytes_programmed;
+
+    printf("Flash benchmark, %d updates of %d bytes:\n", updates, (int)sizeof(data));
+    printf("\tRecord log: %lu erases, %lu bytes programmed (%lu.%02lu erases, %lu bytes per update)\n",
+           (unsigned long)erases, (unsigned long)bytes,
+           (unsigned long)(erases / updates), (unsigned long)((erases * 100 / updates) % 100),
+           (unsigned long)(bytes / updates));
+    printf("\t            %lu of the erases inline, %lu slot flips\n",
+           (unsigned long)inline_erases, (unsigned long)(end.compactions - start.compactions));
+    printf("\t            paths:");
+    for(int i = 0; i < NUM_PATHS; i++)
+        printf(" %s %lu", names[i], (unsigned long)paths[i]);
+    printf("\n");
+    printf("\tOld method: %d erases, %d bytes programmed (1 erase, %d bytes per update)\n",
+           updates, updates * (FLASH_SECTOR_SIZE + FLASH_PAGE_SIZE),
+           FLASH_SECTOR_SIZE + FLASH_PAGE_SIZE);
+}
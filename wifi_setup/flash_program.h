@@ -13,13 +13,70 @@
 #ifndef FLASH_PROGRAMM_H
 #define FLASH_PROGRAMM_H
 
-// The wifi-configuration data goes into page 0
-// (Pages go from 0 to FLASH_PAGES_PER_SECTOR)
-#define WIFI_CONFIG_PAGE 0
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
+// Number of sectors at the end of the flash used for storage.
+// Erases are spread evenly over them, e.g. cmake -DFLASH_SECTORS=8
+#ifndef FLASH_SECTORS
+#define FLASH_SECTORS 2
+#endif
+
+// The wifi-configuration data is stored under this key
+#define WIFI_CONFIG_KEY "wifi"
+
+// Keys are strings of up to KV_KEY_MAX characters
+#define KV_KEY_MAX 15
+// Maximum number of keys (a power of 2)
+#define KV_MAX_KEYS 32
+
+// Pointers returned by kv_get() are aligned to this
+#define FLASH_VIEW_ALIGN 16
+// Maximum number of bytes that can be stored under a key
+#define FLASH_RECORD_MAX_LEN 4048
+
+// How a write was done
+typedef enum _flash_write_result {
+    FLASH_WRITE_SKIPPED,        // data was already in flash
+    FLASH_WRITE_PROGRAMMED,     // bits cleared in place, no erase
+    FLASH_WRITE_FLIPPED,        // slots flipped, standby was already erased
+    FLASH_WRITE_ERASED,         // an erase was necessary
+    FLASH_WRITE_NEEDS_ERASE,    // (internal) bits would have to be set
+    FLASH_WRITE_FAILED
+} flash_write_result;
+
+// Counters of the physical flash operations
+typedef struct _flash_stats {
+    uint32_t writes;            // records appended
+    uint32_t skipped;           // writes of unchanged data
+    uint32_t erases;            // sector erases
+    uint32_t compactions;       // slot flips caused by a full slot
+    uint32_t inline_erases;     // standby slot was not yet erased at a flip
+    uint32_t bytes_programmed;
+} flash_stats;
+
+// Number of keys flash_commit_async() can hold at the same time
+#ifndef FLASH_COMMIT_MAX
+#define FLASH_COMMIT_MAX 8
+#endif
+
+// Called by flash_commit_async() once the data is in flash
+typedef void (*flash_commit_cb)(flash_write_result result, void *arg);
+
+void flash_init();
+bool flash_prepare_standby();
 void show_stats();
-void flash_erase_page(size_t pageStart, size_t numPages);
-void flash_write_page(uint8_t *data, uint16_t buf_len, size_t pageStart);
+flash_write_result kv_put(const char *key, const void *data, uint16_t len);
+const void *kv_get(const char *key, uint16_t *len);
+flash_write_result kv_delete(const char *key);
+flash_write_result flash_erase_page(size_t pageStart, size_t numPages);
+flash_write_result flash_write_page(const uint8_t *data, uint16_t buf_len, size_t pageStart);
 void flash_read(uint8_t *data,uint16_t len, size_t pageStart);
+bool flash_commit_async(const char *key, const void *data, uint16_t len,
+                        flash_commit_cb callback, void *arg);
+void flash_get_stats(flash_stats *s);
+int flash_erase_counts(uint32_t *counts, int max);
+void flash_benchmark(int updates);
 
 #endif // FLASH_PROGRAMM_H
@@ -14,7 +14,10 @@
 #include "lwip/apps/httpd.h"
 #include "http_server.h"
 #include "pico/cyw43_arch.h"
+#include "hardware/sync.h"
 #include "access_point.h"
+#include "networks.h"
+#include "trace.h"
 
 /*
  * This file contains the code for SSI and CGI handling.
@@ -44,8 +47,22 @@ const char * __not_in_flash("httpd") ssi_tags[] = {
     "B9",      // 11
     "B10",     // 12
     "B11",     // 13
+    "PRIO",    // 14
+    "NET0",    // 15
+    "NET1",    // 16
+    "NET2",    // 17
+    "NET3",    // 18
 };
 
+// One tag per stored network
+static_assert(NETWORKS_MAX <= 4, "index.shtml shows the networks in the tags NET0 to NET3");
+
+// Row of a stored network, the SSID is shortened if it does not fit
+#define NET_ROW "<tr><td>%s</td><td colspan=\"3\">priority %u</td>" \
+                "<td colspan=\"2\">%d/%u ok</td><td colspan=\"2\">" \
+                "<input type=\"checkbox\" name=\"del\" value=\"%d\">remove" \
+                "</td></tr>"
+
 #define HIGHLIGHT "STYLE=\"background-color: #72A4D2;\""
 static uint8_t  lan[3][4];
 bool _need_ip;
@@ -55,6 +72,9 @@ static bool ip_err = false;
 static bool mask_err = false;
 static bool gw_err = false;
 
+static uint8_t priority;
+static uint32_t remove_mask;    // stored networks to be removed
+
 /*
  * ssi_init()
  *
@@ -78,15 +98,17 @@ void ssi_init()
  * SSI is triggered by the file extension ".shtml"
  */
 
+TRACE_SITE(ssi_trace, "http ssi");
+TRACE_SITE(cgi_trace, "http cgi");
+
 u16_t __time_critical_func(ssi_handler)(int iIndex, char *pcInsert, int iInsertLen)
 {
-    // SSID and password may contain quotation marks which must be
-    // converted to "&quote;" for the web site.
-    // So we make the buffer twice the maximum size.
-    // (and hope a full-length password doesn't contain
-    // more than nine quotation marks)
-    // static char webStr[PASSWD_MAX_LEN * 2];
-    char webStr[PASSWD_MAX_LEN * 2];
+    uint32_t t = TRACE_BEGIN();
+    // SSID and password may contain characters which must be
+    // converted to entities (e.g. "&quot;") for the web site.
+    // No insert is longer than LWIP_HTTPD_MAX_TAG_INSERT_LEN, longer
+    // values are shortened by encode_value().
+    char webStr[LWIP_HTTPD_MAX_TAG_INSERT_LEN];
 
     size_t printed = 0;
     switch (iIndex) {
@@ -95,12 +117,12 @@ u16_t __time_critical_func(ssi_handler)(int iIndex, char *pcInsert, int iInsertL
                 printed = snprintf(pcInsert, iInsertLen, "%s", HIGHLIGHT);
                 break;
             }
-            encode_value(_c->ssid, webStr);
+            encode_value(_c->ssid, webStr, sizeof(webStr));
             printed = snprintf(pcInsert, iInsertLen, "value=\"%s\"", webStr);
             break;
         case 1: /* "password" */
         {
-            encode_value(_c->passwd, webStr);
+            encode_value(_c->passwd, webStr, sizeof(webStr));
             printed = snprintf(pcInsert, iInsertLen, "value=\"%s\"", webStr);
         }
         break;
@@ -158,33 +180,85 @@ u16_t __time_critical_func(ssi_handler)(int iIndex, char *pcInsert, int iInsertL
                                    ip4_addr_get_byte(&(_c->gw), iIndex - 10));
             }
             break;
+
+        case 14: /* "priority" of the network entered */
+        {
+            wifi_network nets[NETWORKS_MAX];
+            int n = networks_get(nets, NETWORKS_MAX);
+            unsigned prio = 0;
+
+            for(int i = 0; i < n; i++){
+                if(strcmp(nets[i].ssid, _c->ssid) == 0)
+                    prio = nets[i].priority;
+            }
+            printed = snprintf(pcInsert, iInsertLen, "value=\"%u\"", prio);
+        }
+        break;
+
+        case 15: /* "stored networks" */
+        case 16:
+        case 17:
+        case 18:
+        {
+            wifi_network nets[NETWORKS_MAX];
+            int n = networks_get(nets, NETWORKS_MAX);
+            int i = iIndex - 15;
+
+            if(i >= n)
+                break;
+            int markup = snprintf(NULL, 0, NET_ROW, "", nets[i].priority,
+                                  networks_successes(&nets[i]), nets[i].attempts, i);
+            if(markup >= iInsertLen)
+                break;
+            encode_value(nets[i].ssid, webStr, LWIP_MIN(sizeof(webStr), (size_t)(iInsertLen - markup)));
+            printed = snprintf(pcInsert, iInsertLen, NET_ROW,
+                               webStr, nets[i].priority, networks_successes(&nets[i]),
+                               nets[i].attempts, i);
+        }
+        break;
     }
+    // snprintf() returns the length it would have needed
+    if(printed >= (size_t)iInsertLen)
+        printed = iInsertLen - 1;
     LWIP_ASSERT("sane length", printed <= 0xFFFF);
+    TRACE_END(ssi_trace, t);
     return (u16_t)printed;
 }
 
 /*
  * encode_value()
  *
- * SSID and password may contain quotation marks which must be
- * converted to "&quote;" for the web site.
+ * SSID and password may contain characters which must be converted to
+ * entities for the web site: quotation marks (the value is quoted) and
+ * "<", ">" and "&". At most "size" bytes, including the terminating
+ * zero, are written to "dest", a longer value is shortened.
  */
 
-void encode_value(char *src, char *dest)
+void encode_value(const char *src, char *dest, size_t size)
 {
+    char *end = dest + size - 1;
+
+    if(!size)
+        return;
     while(*src){
-        if(*src == '"'){
-            *dest++ = '&';
-            *dest++ = 'q';
-            *dest++ = 'u';
-            *dest++ = 'o';
-            *dest++ = 't';
-            *dest++ = ';';
-            src++;
+        const char *entity;
+        switch(*src){
+            case '"': entity = "&quot;"; break;
+            case '<': entity = "&lt;";   break;
+            case '>': entity = "&gt;";   break;
+            case '&': entity = "&amp;";  break;
+            default:  entity = NULL;     break;
         }
-        else{
-            *dest++ = *src++;
+        size_t len = entity ? strlen(entity) : 1;
+        if(len > (size_t)(end - dest))
+            break;
+        if(entity){
+            memcpy(dest, entity, len);
+            dest += len;
         }
+        else
+            *dest++ = *src;
+        src++;
     }
     *dest = '\0';
 }
@@ -206,6 +280,31 @@ cgi_init(void)
     http_set_cgi_handlers(cgi_handlers, 1);
 }
 
+/*
+ * update_networks()
+ *
+ * Removes the stored networks checked on the page and adds the network
+ * entered (or updates it, if it is already stored).
+ */
+
+static void update_networks()
+{
+    wifi_network nets[NETWORKS_MAX];
+    int n = networks_get(nets, NETWORKS_MAX);
+
+    for(int i = 0; i < n; i++){
+        if(remove_mask & (1u << i))
+            networks_remove(nets[i].ssid);
+    }
+    if(*(_c->ssid) == '\0')
+        return;
+    // detected by the scan before the access point was started
+    uint32_t auth = access_point_auth(_c->ssid);
+    DEBUG_printf("Security of \"%s\": %s\n", _c->ssid, networks_auth_name(auth));
+    if(!networks_add(_c->ssid, _c->passwd, priority, auth))
+        DEBUG_printf("Network list full\n");
+}
+
 /*
  * cgi_handler()
  *
@@ -215,10 +314,15 @@ cgi_init(void)
 const char *
 cgi_handler(int iIndex, int iNumParams, char *pcParam[], char *pcValue[])
 {
+    uint32_t t = TRACE_BEGIN();
+    const char *page;
+
     memset(lan, 0, sizeof(lan));
     ip_err   = false;
     mask_err = false;
     gw_err   = false;
+    priority = 0;
+    remove_mask = 0;
 
     for (int i = 0; i < iNumParams; i++){
         if(strcmp(pcParam[i], "ssid") == 0){
@@ -227,6 +331,15 @@ cgi_handler(int iIndex, int iNumParams, char *pcParam[], char *pcValue[])
         else if(strcmp(pcParam[i], "passwd") == 0){
             url_decode(pcValue[i], _c->passwd);
         }
+        else if(strcmp(pcParam[i], "prio") == 0){
+            int val = atoi(pcValue[i]);
+            priority = val < 0 ? 0 : val > NETWORK_PRIORITY_MAX ? NETWORK_PRIORITY_MAX : val;
+        }
+        else if(strcmp(pcParam[i], "del") == 0){
+            int val = atoi(pcValue[i]);
+            if(val >= 0 && val < NETWORKS_MAX)
+                remove_mask |= 1u << val;
+        }
         else if(pcParam[i][0] == 'B'){
             uint8_t index = atoi(&(pcParam[i][1]));
             int val = atoi(pcValue[i]);
@@ -292,13 +405,18 @@ cgi_handler(int iIndex, int iNumParams, char *pcParam[], char *pcValue[])
         DEBUG_printf("Configure ERROR\n");
 
     if(!(ip_err || mask_err || gw_err)){
+        // stored by the caller of run_access_point()
         _c->magic = MAGIC;
+        update_networks();
         isConfigured = true;
-        return "/done.html";
+        __sev();    // wakes run_access_point()
+        page = "/done.html";
     }
     else{
-        return "/index.shtml";
+        page = "/index.shtml";
     }
+    TRACE_END(cgi_trace, t);
+    return page;
 }
 
 /*
@@ -15,7 +15,7 @@
 
 void ssi_init();
 u16_t __time_critical_func(ssi_handler)(int iIndex, char *pcInsert, int iInsertLen);
-void encode_value(char *src, char *dest);
+void encode_value(const char *src, char *dest, size_t size);
 
 void cgi_init(void);
 const char *cgi_handler(int iIndex, int iNumParams, char *pcParam[], char *pcValue[]);
@@ -71,248 +71,300 @@ static const unsigned char data_index_shtml[] = {
 	0x72, 0x20, 0x77, 0x69, 0x72, 0x65, 0x6c, 0x65, 0x73, 0x73, 
 	0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x20, 0x6f, 
 	0x6e, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x70, 0x61, 0x67, 
-	0x65, 0x2e, 0x3c, 0x42, 0x52, 0x3e, 0xd, 0xa, 0x9, 0x49, 
-	0x66, 0x20, 0x79, 0x6f, 0x75, 0x72, 0x20, 0x6e, 0x65, 0x74, 
-	0x77, 0x6f, 0x72, 0x6b, 0x20, 0x73, 0x75, 0x70, 0x70, 0x6f, 
-	0x72, 0x74, 0x73, 0x20, 0x44, 0x48, 0x43, 0x50, 0x20, 0x61, 
-	0x6e, 0x64, 0x20, 0x79, 0x6f, 0x75, 0x20, 0x64, 0x6f, 0x20, 
-	0x6e, 0x6f, 0x74, 0x20, 0x77, 0x61, 0x6e, 0x74, 0x20, 0x74, 
-	0x6f, 0x20, 0x61, 0x73, 0x73, 0x69, 0x67, 0x6e, 0x20, 0x61, 
-	0x20, 0x66, 0x69, 0x78, 0x65, 0x64, 0x20, 0x49, 0x50, 0x20, 
-	0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x2c, 0x20, 0x6c, 
-	0x65, 0x61, 0x76, 0x65, 0x20, 0x74, 0x68, 0x65, 0x20, 0x22, 
-	0x49, 0x50, 0x20, 0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 
-	0x22, 0x2c, 0x20, 0x22, 0x4e, 0x65, 0x74, 0x6d, 0x61, 0x73, 
-	0x6b, 0x22, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x22, 0x44, 0x65, 
-	0x66, 0x61, 0x75, 0x6c, 0x74, 0x20, 0x47, 0x61, 0x74, 0x65, 
-	0x77, 0x61, 0x79, 0x22, 0x20, 0x66, 0x69, 0x65, 0x6c, 0x64, 
-	0x73, 0x20, 0x65, 0x6d, 0x70, 0x74, 0x79, 0x2e, 0x3c, 0x62, 
-	0x72, 0x3e, 0x3c, 0x62, 0x72, 0x3e, 0xd, 0xa, 0xd, 0xa, 
-	0x9, 0x43, 0x6c, 0x69, 0x63, 0x6b, 0x20, 0x6f, 0x6e, 0x20, 
-	0x22, 0x53, 0x65, 0x74, 0x75, 0x70, 0x22, 0x20, 0x74, 0x6f, 
-	0x20, 0x73, 0x61, 0x76, 0x65, 0x2e, 0x20, 0x54, 0x68, 0x65, 
-	0x20, 0x50, 0x69, 0x63, 0x6f, 0x2d, 0x57, 0x20, 0x72, 0x65, 
-	0x73, 0x74, 0x61, 0x72, 0x74, 0x73, 0x20, 0x61, 0x6e, 0x64, 
-	0x20, 0x63, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x73, 0x20, 
-	0x74, 0x6f, 0x20, 0x79, 0x6f, 0x75, 0x72, 0x20, 0x77, 0x69, 
-	0x72, 0x65, 0x6c, 0x65, 0x73, 0x73, 0x20, 0x6e, 0x65, 0x74, 
-	0x77, 0x6f, 0x72, 0x6b, 0x2e, 0x3c, 0x62, 0x72, 0x3e, 0xd, 
-	0xa, 0x9, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0xd, 0xa, 
-	0x9, 0x3c, 0x62, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x3c, 0x66, 
-	0x6f, 0x72, 0x6d, 0x20, 0x6d, 0x65, 0x74, 0x68, 0x6f, 0x64, 
-	0x3d, 0x22, 0x67, 0x65, 0x74, 0x22, 0x20, 0x61, 0x63, 0x74, 
-	0x69, 0x6f, 0x6e, 0x3d, 0x22, 0x2f, 0x73, 0x65, 0x74, 0x75, 
-	0x70, 0x2e, 0x63, 0x67, 0x69, 0x22, 0x3e, 0xd, 0xa, 0x9, 
-	0x9, 0x3c, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x3e, 0xd, 0xa, 
-	0x9, 0x9, 0x3c, 0x74, 0x72, 0x3e, 0x3c, 0x74, 0x64, 0x20, 
-	0x20, 0x63, 0x6f, 0x6c, 0x73, 0x70, 0x61, 0x6e, 0x3d, 0x22, 
-	0x38, 0x22, 0x3e, 0x3c, 0x62, 0x3e, 0x57, 0x69, 0x2d, 0x46, 
-	0x69, 0x3c, 0x2f, 0x62, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 
-	0x3c, 0x2f, 0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 
-	0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 
-	0x64, 0x3e, 0x3c, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x20, 0x66, 
-	0x6f, 0x72, 0x3d, 0x22, 0x73, 0x73, 0x69, 0x64, 0x22, 0x3e, 
-	0x53, 0x53, 0x49, 0x44, 0x3a, 0x3c, 0x2f, 0x6c, 0x61, 0x62, 
+	0x65, 0x2e, 0x3c, 0x42, 0x52, 0x3e, 0xd, 0xa, 0x9, 0x55, 
+	0x70, 0x20, 0x74, 0x6f, 0x20, 0x66, 0x6f, 0x75, 0x72, 0x20, 
+	0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x73, 0x20, 0x61, 
+	0x72, 0x65, 0x20, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x2e, 
+	0x20, 0x54, 0x68, 0x65, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 
+	0x72, 0x6b, 0x20, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x65, 0x64, 
+	0x20, 0x62, 0x65, 0x6c, 0x6f, 0x77, 0x20, 0x69, 0x73, 0x20, 
+	0x61, 0x64, 0x64, 0x65, 0x64, 0x20, 0x74, 0x6f, 0x20, 0x74, 
+	0x68, 0x65, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x2c, 0x20, 0x6f, 
+	0x72, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x64, 0x20, 
+	0x69, 0x66, 0x20, 0x69, 0x74, 0x20, 0x69, 0x73, 0x20, 0x61, 
+	0x6c, 0x72, 0x65, 0x61, 0x64, 0x79, 0x20, 0x73, 0x74, 0x6f, 
+	0x72, 0x65, 0x64, 0x2e, 0x20, 0x41, 0x74, 0x20, 0x62, 0x6f, 
+	0x6f, 0x74, 0x20, 0x74, 0x68, 0x65, 0x20, 0x50, 0x69, 0x63, 
+	0x6f, 0x2d, 0x57, 0x20, 0x63, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 
+	0x74, 0x73, 0x20, 0x74, 0x6f, 0x20, 0x74, 0x68, 0x65, 0x20, 
+	0x62, 0x65, 0x73, 0x74, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 
+	0x72, 0x6b, 0x20, 0x69, 0x6e, 0x20, 0x72, 0x61, 0x6e, 0x67, 
+	0x65, 0x3a, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 
+	0x73, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 0x61, 0x20, 0x68, 
+	0x69, 0x67, 0x68, 0x65, 0x72, 0x20, 0x70, 0x72, 0x69, 0x6f, 
+	0x72, 0x69, 0x74, 0x79, 0x20, 0x61, 0x72, 0x65, 0x20, 0x70, 
+	0x72, 0x65, 0x66, 0x65, 0x72, 0x72, 0x65, 0x64, 0x2e, 0x3c, 
+	0x62, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x49, 0x66, 0x20, 0x79, 
+	0x6f, 0x75, 0x72, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 
+	0x6b, 0x20, 0x73, 0x75, 0x70, 0x70, 0x6f, 0x72, 0x74, 0x73, 
+	0x20, 0x44, 0x48, 0x43, 0x50, 0x20, 0x61, 0x6e, 0x64, 0x20, 
+	0x79, 0x6f, 0x75, 0x20, 0x64, 0x6f, 0x20, 0x6e, 0x6f, 0x74, 
+	0x20, 0x77, 0x61, 0x6e, 0x74, 0x20, 0x74, 0x6f, 0x20, 0x61, 
+	0x73, 0x73, 0x69, 0x67, 0x6e, 0x20, 0x61, 0x20, 0x66, 0x69, 
+	0x78, 0x65, 0x64, 0x20, 0x49, 0x50, 0x20, 0x61, 0x64, 0x64, 
+	0x72, 0x65, 0x73, 0x73, 0x2c, 0x20, 0x6c, 0x65, 0x61, 0x76, 
+	0x65, 0x20, 0x74, 0x68, 0x65, 0x20, 0x22, 0x49, 0x50, 0x20, 
+	0x61, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x22, 0x2c, 0x20, 
+	0x22, 0x4e, 0x65, 0x74, 0x6d, 0x61, 0x73, 0x6b, 0x22, 0x20, 
+	0x61, 0x6e, 0x64, 0x20, 0x22, 0x44, 0x65, 0x66, 0x61, 0x75, 
+	0x6c, 0x74, 0x20, 0x47, 0x61, 0x74, 0x65, 0x77, 0x61, 0x79, 
+	0x22, 0x20, 0x66, 0x69, 0x65, 0x6c, 0x64, 0x73, 0x20, 0x65, 
+	0x6d, 0x70, 0x74, 0x79, 0x2e, 0x3c, 0x62, 0x72, 0x3e, 0x3c, 
+	0x62, 0x72, 0x3e, 0xd, 0xa, 0xd, 0xa, 0x9, 0x43, 0x6c, 
+	0x69, 0x63, 0x6b, 0x20, 0x6f, 0x6e, 0x20, 0x22, 0x53, 0x65, 
+	0x74, 0x75, 0x70, 0x22, 0x20, 0x74, 0x6f, 0x20, 0x73, 0x61, 
+	0x76, 0x65, 0x2e, 0x20, 0x54, 0x68, 0x65, 0x20, 0x50, 0x69, 
+	0x63, 0x6f, 0x2d, 0x57, 0x20, 0x72, 0x65, 0x73, 0x74, 0x61, 
+	0x72, 0x74, 0x73, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x63, 0x6f, 
+	0x6e, 0x6e, 0x65, 0x63, 0x74, 0x73, 0x20, 0x74, 0x6f, 0x20, 
+	0x79, 0x6f, 0x75, 0x72, 0x20, 0x77, 0x69, 0x72, 0x65, 0x6c, 
+	0x65, 0x73, 0x73, 0x20, 0x6e, 0x65, 0x74, 0x77, 0x6f, 0x72, 
+	0x6b, 0x2e, 0x3c, 0x62, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x3c, 
+	0x2f, 0x64, 0x69, 0x76, 0x3e, 0xd, 0xa, 0x9, 0x3c, 0x62, 
+	0x72, 0x3e, 0xd, 0xa, 0x9, 0x3c, 0x66, 0x6f, 0x72, 0x6d, 
+	0x20, 0x6d, 0x65, 0x74, 0x68, 0x6f, 0x64, 0x3d, 0x22, 0x67, 
+	0x65, 0x74, 0x22, 0x20, 0x61, 0x63, 0x74, 0x69, 0x6f, 0x6e, 
+	0x3d, 0x22, 0x2f, 0x73, 0x65, 0x74, 0x75, 0x70, 0x2e, 0x63, 
+	0x67, 0x69, 0x22, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 0x74, 
+	0x61, 0x62, 0x6c, 0x65, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 
+	0x74, 0x72, 0x3e, 0x3c, 0x74, 0x64, 0x20, 0x20, 0x63, 0x6f, 
+	0x6c, 0x73, 0x70, 0x61, 0x6e, 0x3d, 0x22, 0x38, 0x22, 0x3e, 
+	0x3c, 0x62, 0x3e, 0x57, 0x69, 0x2d, 0x46, 0x69, 0x3c, 0x2f, 
+	0x62, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x2f, 0x74, 
+	0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 0x74, 0x72, 0x3e, 
+	0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 
+	0x6c, 0x61, 0x62, 0x65, 0x6c, 0x20, 0x66, 0x6f, 0x72, 0x3d, 
+	0x22, 0x73, 0x73, 0x69, 0x64, 0x22, 0x3e, 0x53, 0x53, 0x49, 
+	0x44, 0x3a, 0x3c, 0x2f, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 
+	0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 
+	0x3c, 0x74, 0x64, 0x20, 0x63, 0x6f, 0x6c, 0x73, 0x70, 0x61, 
+	0x6e, 0x3d, 0x22, 0x37, 0x22, 0x3e, 0x3c, 0x69, 0x6e, 0x70, 
+	0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x74, 
+	0x65, 0x78, 0x74, 0x22, 0x20, 0x69, 0x64, 0x3d, 0x22, 0x73, 
+	0x73, 0x69, 0x64, 0x22, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 
+	0x22, 0x73, 0x73, 0x69, 0x64, 0x22, 0x20, 0x6d, 0x61, 0x78, 
+	0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3d, 0x22, 0x33, 0x32, 
+	0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x53, 0x53, 0x49, 
+	0x44, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 
+	0xd, 0xa, 0x9, 0x9, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0xd, 
+	0xa, 0x9, 0x9, 0x3c, 0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 
+	0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x6c, 0x61, 0x62, 
+	0x65, 0x6c, 0x20, 0x66, 0x6f, 0x72, 0x3d, 0x22, 0x70, 0x61, 
+	0x73, 0x73, 0x77, 0x64, 0x22, 0x3e, 0x50, 0x61, 0x73, 0x73, 
+	0x77, 0x6f, 0x72, 0x64, 0x3a, 0x3c, 0x2f, 0x6c, 0x61, 0x62, 
 	0x65, 0x6c, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 
 	0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x20, 0x63, 0x6f, 0x6c, 
 	0x73, 0x70, 0x61, 0x6e, 0x3d, 0x22, 0x37, 0x22, 0x3e, 0x3c, 
 	0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 
-	0x3d, 0x22, 0x74, 0x65, 0x78, 0x74, 0x22, 0x20, 0x69, 0x64, 
-	0x3d, 0x22, 0x73, 0x73, 0x69, 0x64, 0x22, 0x20, 0x6e, 0x61, 
-	0x6d, 0x65, 0x3d, 0x22, 0x73, 0x73, 0x69, 0x64, 0x22, 0x20, 
-	0x6d, 0x61, 0x78, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3d, 
-	0x22, 0x33, 0x32, 0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 
-	0x53, 0x53, 0x49, 0x44, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 
-	0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 0x2f, 0x74, 
+	0x3d, 0x22, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 
+	0x22, 0x20, 0x69, 0x64, 0x3d, 0x22, 0x70, 0x61, 0x73, 0x73, 
+	0x77, 0x64, 0x22, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 
+	0x70, 0x61, 0x73, 0x73, 0x77, 0x64, 0x22, 0x20, 0x6d, 0x61, 
+	0x78, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3d, 0x22, 0x36, 
+	0x33, 0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x50, 0x41, 
+	0x53, 0x53, 0x57, 0x44, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 
+	0x74, 0x64, 0x3e, 0xd, 0xa, 0x20, 0x20, 0x20, 0x20, 0x20, 
+	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x74, 
 	0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 0x74, 0x72, 0x3e, 
 	0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 
 	0x6c, 0x61, 0x62, 0x65, 0x6c, 0x20, 0x66, 0x6f, 0x72, 0x3d, 
-	0x22, 0x70, 0x61, 0x73, 0x73, 0x77, 0x64, 0x22, 0x3e, 0x50, 
-	0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x3a, 0x3c, 0x2f, 
-	0x6c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 
-	0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x20, 
-	0x63, 0x6f, 0x6c, 0x73, 0x70, 0x61, 0x6e, 0x3d, 0x22, 0x37, 
-	0x22, 0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 
-	0x79, 0x70, 0x65, 0x3d, 0x22, 0x70, 0x61, 0x73, 0x73, 0x77, 
-	0x6f, 0x72, 0x64, 0x22, 0x20, 0x69, 0x64, 0x3d, 0x22, 0x70, 
-	0x61, 0x73, 0x73, 0x77, 0x64, 0x22, 0x20, 0x6e, 0x61, 0x6d, 
-	0x65, 0x3d, 0x22, 0x70, 0x61, 0x73, 0x73, 0x77, 0x64, 0x22, 
-	0x20, 0x6d, 0x61, 0x78, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 
-	0x3d, 0x22, 0x36, 0x33, 0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 
-	0x23, 0x50, 0x41, 0x53, 0x53, 0x57, 0x44, 0x2d, 0x2d, 0x3e, 
-	0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x20, 0x20, 
-	0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
-	0x3c, 0x2f, 0x74, 0x72, 0x3e, 0xd, 0xa, 0xd, 0xa, 0x9, 
-	0x9, 0x3c, 0x74, 0x72, 0x3e, 0x3c, 0x74, 0x64, 0x20, 0x20, 
-	0x63, 0x6f, 0x6c, 0x73, 0x70, 0x61, 0x6e, 0x3d, 0x22, 0x38, 
-	0x22, 0x3e, 0x3c, 0x62, 0x72, 0x3e, 0x3c, 0x62, 0x3e, 0x4c, 
-	0x41, 0x4e, 0x3c, 0x2f, 0x62, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 
-	0x3e, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 
-	0x3c, 0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 
-	0x74, 0x64, 0x3e, 0x3c, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 
-	0x49, 0x50, 0x2d, 0x41, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 
-	0x3a, 0x3c, 0x2f, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 0x3c, 
-	0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 
-	0x74, 0x64, 0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 
-	0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 
-	0x74, 0x22, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 
-	0x30, 0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 0x33, 
-	0x22, 0x20, 0x70, 0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 0x3d, 
-	0x22, 0x5b, 0x30, 0x2d, 0x39, 0x5d, 0x7b, 0x31, 0x2c, 0x33, 
-	0x7d, 0x22, 0x20, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3d, 0x22, 
-	0x30, 0x20, 0x2d, 0x20, 0x32, 0x35, 0x35, 0x22, 0x20, 0x3c, 
-	0x21, 0x2d, 0x2d, 0x23, 0x42, 0x30, 0x2d, 0x2d, 0x3e, 0x3e, 
-	0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 
-	0x3c, 0x74, 0x64, 0x20, 0x61, 0x6c, 0x69, 0x67, 0x6e, 0x20, 
-	0x3d, 0x22, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x22, 0x3e, 
-	0x2e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 
-	0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 
-	0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x69, 0x6e, 
-	0x70, 0x75, 0x74, 0x22, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 
-	0x22, 0x42, 0x31, 0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 
-	0x22, 0x33, 0x22, 0x20, 0x70, 0x61, 0x74, 0x74, 0x65, 0x72, 
-	0x6e, 0x3d, 0x22, 0x5b, 0x30, 0x2d, 0x39, 0x5d, 0x7b, 0x31, 
-	0x2c, 0x33, 0x7d, 0x22, 0x20, 0x74, 0x69, 0x74, 0x6c, 0x65, 
-	0x3d, 0x22, 0x30, 0x20, 0x2d, 0x20, 0x32, 0x35, 0x35, 0x22, 
-	0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x42, 0x31, 0x2d, 0x2d, 
+	0x22, 0x70, 0x72, 0x69, 0x6f, 0x22, 0x3e, 0x50, 0x72, 0x69, 
+	0x6f, 0x72, 0x69, 0x74, 0x79, 0x3a, 0x3c, 0x2f, 0x6c, 0x61, 
+	0x62, 0x65, 0x6c, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 
+	0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x20, 0x63, 0x6f, 
+	0x6c, 0x73, 0x70, 0x61, 0x6e, 0x3d, 0x22, 0x37, 0x22, 0x3e, 
+	0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 
+	0x65, 0x3d, 0x22, 0x6e, 0x75, 0x6d, 0x62, 0x65, 0x72, 0x22, 
+	0x20, 0x69, 0x64, 0x3d, 0x22, 0x70, 0x72, 0x69, 0x6f, 0x22, 
+	0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x70, 0x72, 0x69, 
+	0x6f, 0x22, 0x20, 0x6d, 0x69, 0x6e, 0x3d, 0x22, 0x30, 0x22, 
+	0x20, 0x6d, 0x61, 0x78, 0x3d, 0x22, 0x39, 0x22, 0x20, 0x3c, 
+	0x21, 0x2d, 0x2d, 0x23, 0x50, 0x52, 0x49, 0x4f, 0x2d, 0x2d, 
 	0x3e, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 
-	0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x2e, 0x3c, 0x2f, 0x74, 
+	0x9, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0xd, 0xa, 0xd, 0xa, 
+	0x9, 0x9, 0x3c, 0x74, 0x72, 0x3e, 0x3c, 0x74, 0x64, 0x20, 
+	0x20, 0x63, 0x6f, 0x6c, 0x73, 0x70, 0x61, 0x6e, 0x3d, 0x22, 
+	0x38, 0x22, 0x3e, 0x3c, 0x62, 0x72, 0x3e, 0x3c, 0x62, 0x3e, 
+	0x53, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x20, 0x6e, 0x65, 0x74, 
+	0x77, 0x6f, 0x72, 0x6b, 0x73, 0x3c, 0x2f, 0x62, 0x3e, 0x3c, 
+	0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0xd, 
+	0xa, 0x9, 0x9, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x4e, 0x45, 
+	0x54, 0x30, 0x2d, 0x2d, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 
+	0x21, 0x2d, 0x2d, 0x23, 0x4e, 0x45, 0x54, 0x31, 0x2d, 0x2d, 
+	0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 
+	0x4e, 0x45, 0x54, 0x32, 0x2d, 0x2d, 0x3e, 0xd, 0xa, 0x9, 
+	0x9, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x4e, 0x45, 0x54, 0x33, 
+	0x2d, 0x2d, 0x3e, 0xd, 0xa, 0xd, 0xa, 0x9, 0x9, 0x3c, 
+	0x74, 0x72, 0x3e, 0x3c, 0x74, 0x64, 0x20, 0x20, 0x63, 0x6f, 
+	0x6c, 0x73, 0x70, 0x61, 0x6e, 0x3d, 0x22, 0x38, 0x22, 0x3e, 
+	0x3c, 0x62, 0x72, 0x3e, 0x3c, 0x62, 0x3e, 0x4c, 0x41, 0x4e, 
+	0x3c, 0x2f, 0x62, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 
+	0x2f, 0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 0x74, 
+	0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 
+	0x3e, 0x3c, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 0x49, 0x50, 
+	0x2d, 0x41, 0x64, 0x64, 0x72, 0x65, 0x73, 0x73, 0x3a, 0x3c, 
+	0x2f, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 0x3c, 0x2f, 0x74, 
 	0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 
 	0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 
 	0x70, 0x65, 0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x22, 
-	0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 0x32, 0x22, 
+	0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 0x30, 0x22, 
 	0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 0x33, 0x22, 0x20, 
 	0x70, 0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 0x3d, 0x22, 0x5b, 
 	0x30, 0x2d, 0x39, 0x5d, 0x7b, 0x31, 0x2c, 0x33, 0x7d, 0x22, 
 	0x20, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3d, 0x22, 0x30, 0x20, 
 	0x2d, 0x20, 0x32, 0x35, 0x35, 0x22, 0x20, 0x3c, 0x21, 0x2d, 
-	0x2d, 0x23, 0x42, 0x32, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 
-	0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 
-	0x64, 0x3e, 0x2e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 
-	0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x69, 0x6e, 
-	0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 
-	0x69, 0x6e, 0x70, 0x75, 0x74, 0x22, 0x20, 0x6e, 0x61, 0x6d, 
-	0x65, 0x3d, 0x22, 0x42, 0x33, 0x22, 0x20, 0x73, 0x69, 0x7a, 
-	0x65, 0x3d, 0x22, 0x33, 0x22, 0x20, 0x70, 0x61, 0x74, 0x74, 
-	0x65, 0x72, 0x6e, 0x3d, 0x22, 0x5b, 0x30, 0x2d, 0x39, 0x5d, 
-	0x7b, 0x31, 0x2c, 0x33, 0x7d, 0x22, 0x20, 0x74, 0x69, 0x74, 
-	0x6c, 0x65, 0x3d, 0x22, 0x30, 0x20, 0x2d, 0x20, 0x32, 0x35, 
-	0x35, 0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x42, 0x33, 
-	0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 
-	0xa, 0x9, 0x9, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0xd, 0xa, 
-	0x9, 0x9, 0x3c, 0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 
-	0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x6c, 0x61, 0x62, 0x65, 
-	0x6c, 0x3e, 0x4e, 0x65, 0x74, 0x6d, 0x61, 0x73, 0x6b, 0x3a, 
-	0x3c, 0x2f, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 0x3c, 0x2f, 
+	0x2d, 0x23, 0x42, 0x30, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 
 	0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 
-	0x64, 0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 
-	0x79, 0x70, 0x65, 0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 0x74, 
-	0x22, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 0x34, 
-	0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 0x33, 0x22, 
-	0x20, 0x70, 0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 0x3d, 0x22, 
-	0x5b, 0x30, 0x2d, 0x39, 0x5d, 0x7b, 0x31, 0x2c, 0x33, 0x7d, 
-	0x22, 0x20, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3d, 0x22, 0x30, 
-	0x20, 0x2d, 0x20, 0x32, 0x35, 0x35, 0x22, 0x20, 0x3c, 0x21, 
-	0x2d, 0x2d, 0x23, 0x42, 0x34, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 
-	0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 
-	0x74, 0x64, 0x3e, 0x2e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 
-	0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x69, 
-	0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 
-	0x22, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x22, 0x20, 0x6e, 0x61, 
-	0x6d, 0x65, 0x3d, 0x22, 0x42, 0x35, 0x22, 0x20, 0x73, 0x69, 
-	0x7a, 0x65, 0x3d, 0x22, 0x33, 0x22, 0x20, 0x70, 0x61, 0x74, 
-	0x74, 0x65, 0x72, 0x6e, 0x3d, 0x22, 0x5b, 0x30, 0x2d, 0x39, 
-	0x5d, 0x7b, 0x31, 0x2c, 0x33, 0x7d, 0x22, 0x20, 0x74, 0x69, 
-	0x74, 0x6c, 0x65, 0x3d, 0x22, 0x30, 0x20, 0x2d, 0x20, 0x32, 
-	0x35, 0x35, 0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x42, 
-	0x35, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 
-	0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x2e, 
-	0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 
-	0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 
-	0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x69, 0x6e, 0x70, 
-	0x75, 0x74, 0x22, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 
-	0x42, 0x36, 0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 
-	0x33, 0x22, 0x20, 0x70, 0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 
-	0x3d, 0x22, 0x5b, 0x30, 0x2d, 0x39, 0x5d, 0x7b, 0x31, 0x2c, 
-	0x33, 0x7d, 0x22, 0x20, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3d, 
-	0x22, 0x30, 0x20, 0x2d, 0x20, 0x32, 0x35, 0x35, 0x22, 0x20, 
-	0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x42, 0x36, 0x2d, 0x2d, 0x3e, 
-	0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 
-	0x9, 0x3c, 0x74, 0x64, 0x3e, 0x2e, 0x3c, 0x2f, 0x74, 0x64, 
-	0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 
-	0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 
-	0x65, 0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x22, 0x20, 
-	0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 0x37, 0x22, 0x20, 
-	0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 0x33, 0x22, 0x20, 0x70, 
-	0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 0x3d, 0x22, 0x5b, 0x30, 
-	0x2d, 0x39, 0x5d, 0x7b, 0x31, 0x2c, 0x33, 0x7d, 0x22, 0x20, 
-	0x74, 0x69, 0x74, 0x6c, 0x65, 0x3d, 0x22, 0x30, 0x20, 0x2d, 
-	0x20, 0x32, 0x35, 0x35, 0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 
-	0x23, 0x42, 0x37, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 0x74, 
-	0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 0x2f, 0x74, 0x72, 
-	0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 0x74, 0x72, 0x3e, 0xd, 
-	0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x6c, 
-	0x61, 0x62, 0x65, 0x6c, 0x3e, 0x44, 0x65, 0x66, 0x61, 0x75, 
-	0x6c, 0x74, 0x20, 0x47, 0x61, 0x74, 0x65, 0x77, 0x61, 0x79, 
-	0x3a, 0x3c, 0x2f, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 0x3c, 
+	0x64, 0x20, 0x61, 0x6c, 0x69, 0x67, 0x6e, 0x20, 0x3d, 0x22, 
+	0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x22, 0x3e, 0x2e, 0x3c, 
 	0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 
 	0x74, 0x64, 0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 
 	0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 
 	0x74, 0x22, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 
-	0x38, 0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 0x33, 
+	0x31, 0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 0x33, 
 	0x22, 0x20, 0x70, 0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 0x3d, 
 	0x22, 0x5b, 0x30, 0x2d, 0x39, 0x5d, 0x7b, 0x31, 0x2c, 0x33, 
 	0x7d, 0x22, 0x20, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3d, 0x22, 
 	0x30, 0x20, 0x2d, 0x20, 0x32, 0x35, 0x35, 0x22, 0x20, 0x3c, 
-	0x21, 0x2d, 0x2d, 0x23, 0x42, 0x38, 0x2d, 0x2d, 0x3e, 0x3e, 
+	0x21, 0x2d, 0x2d, 0x23, 0x42, 0x31, 0x2d, 0x2d, 0x3e, 0x3e, 
 	0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 
 	0x3c, 0x74, 0x64, 0x3e, 0x2e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 
 	0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 
 	0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 
 	0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x22, 0x20, 0x6e, 
-	0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 0x39, 0x22, 0x20, 0x73, 
+	0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 0x32, 0x22, 0x20, 0x73, 
 	0x69, 0x7a, 0x65, 0x3d, 0x22, 0x33, 0x22, 0x20, 0x70, 0x61, 
 	0x74, 0x74, 0x65, 0x72, 0x6e, 0x3d, 0x22, 0x5b, 0x30, 0x2d, 
 	0x39, 0x5d, 0x7b, 0x31, 0x2c, 0x33, 0x7d, 0x22, 0x20, 0x74, 
 	0x69, 0x74, 0x6c, 0x65, 0x3d, 0x22, 0x30, 0x20, 0x2d, 0x20, 
 	0x32, 0x35, 0x35, 0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 
-	0x42, 0x39, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 
+	0x42, 0x32, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 
 	0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 
 	0x2e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 
 	0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 
 	0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x69, 0x6e, 
 	0x70, 0x75, 0x74, 0x22, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 
-	0x22, 0x42, 0x31, 0x30, 0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 
+	0x22, 0x42, 0x33, 0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 
+	0x22, 0x33, 0x22, 0x20, 0x70, 0x61, 0x74, 0x74, 0x65, 0x72, 
+	0x6e, 0x3d, 0x22, 0x5b, 0x30, 0x2d, 0x39, 0x5d, 0x7b, 0x31, 
+	0x2c, 0x33, 0x7d, 0x22, 0x20, 0x74, 0x69, 0x74, 0x6c, 0x65, 
+	0x3d, 0x22, 0x30, 0x20, 0x2d, 0x20, 0x32, 0x35, 0x35, 0x22, 
+	0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x42, 0x33, 0x2d, 0x2d, 
+	0x3e, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 
+	0x9, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 
+	0x3c, 0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 
+	0x74, 0x64, 0x3e, 0x3c, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 
+	0x4e, 0x65, 0x74, 0x6d, 0x61, 0x73, 0x6b, 0x3a, 0x3c, 0x2f, 
+	0x6c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 
+	0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 
+	0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 
+	0x65, 0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x22, 0x20, 
+	0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 0x34, 0x22, 0x20, 
+	0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 0x33, 0x22, 0x20, 0x70, 
+	0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 0x3d, 0x22, 0x5b, 0x30, 
+	0x2d, 0x39, 0x5d, 0x7b, 0x31, 0x2c, 0x33, 0x7d, 0x22, 0x20, 
+	0x74, 0x69, 0x74, 0x6c, 0x65, 0x3d, 0x22, 0x30, 0x20, 0x2d, 
+	0x20, 0x32, 0x35, 0x35, 0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 
+	0x23, 0x42, 0x34, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 0x74, 
+	0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 
+	0x3e, 0x2e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 
+	0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x69, 0x6e, 0x70, 
+	0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x69, 
+	0x6e, 0x70, 0x75, 0x74, 0x22, 0x20, 0x6e, 0x61, 0x6d, 0x65, 
+	0x3d, 0x22, 0x42, 0x35, 0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 
 	0x3d, 0x22, 0x33, 0x22, 0x20, 0x70, 0x61, 0x74, 0x74, 0x65, 
 	0x72, 0x6e, 0x3d, 0x22, 0x5b, 0x30, 0x2d, 0x39, 0x5d, 0x7b, 
 	0x31, 0x2c, 0x33, 0x7d, 0x22, 0x20, 0x74, 0x69, 0x74, 0x6c, 
 	0x65, 0x3d, 0x22, 0x30, 0x20, 0x2d, 0x20, 0x32, 0x35, 0x35, 
-	0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x42, 0x31, 0x30, 
+	0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x42, 0x35, 0x2d, 
+	0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 
+	0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x2e, 0x3c, 0x2f, 
+	0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 
+	0x64, 0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 
+	0x79, 0x70, 0x65, 0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 0x74, 
+	0x22, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 0x36, 
+	0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 0x33, 0x22, 
+	0x20, 0x70, 0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 0x3d, 0x22, 
+	0x5b, 0x30, 0x2d, 0x39, 0x5d, 0x7b, 0x31, 0x2c, 0x33, 0x7d, 
+	0x22, 0x20, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3d, 0x22, 0x30, 
+	0x20, 0x2d, 0x20, 0x32, 0x35, 0x35, 0x22, 0x20, 0x3c, 0x21, 
+	0x2d, 0x2d, 0x23, 0x42, 0x36, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 
+	0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 
+	0x74, 0x64, 0x3e, 0x2e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 
+	0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x69, 
+	0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 
+	0x22, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x22, 0x20, 0x6e, 0x61, 
+	0x6d, 0x65, 0x3d, 0x22, 0x42, 0x37, 0x22, 0x20, 0x73, 0x69, 
+	0x7a, 0x65, 0x3d, 0x22, 0x33, 0x22, 0x20, 0x70, 0x61, 0x74, 
+	0x74, 0x65, 0x72, 0x6e, 0x3d, 0x22, 0x5b, 0x30, 0x2d, 0x39, 
+	0x5d, 0x7b, 0x31, 0x2c, 0x33, 0x7d, 0x22, 0x20, 0x74, 0x69, 
+	0x74, 0x6c, 0x65, 0x3d, 0x22, 0x30, 0x20, 0x2d, 0x20, 0x32, 
+	0x35, 0x35, 0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x42, 
+	0x37, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 
+	0xd, 0xa, 0x9, 0x9, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0xd, 
+	0xa, 0x9, 0x9, 0x3c, 0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 
+	0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x6c, 0x61, 0x62, 
+	0x65, 0x6c, 0x3e, 0x44, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 
+	0x20, 0x47, 0x61, 0x74, 0x65, 0x77, 0x61, 0x79, 0x3a, 0x3c, 
+	0x2f, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 0x3c, 0x2f, 0x74, 
+	0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 
+	0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 
+	0x70, 0x65, 0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x22, 
+	0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 0x38, 0x22, 
+	0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 0x33, 0x22, 0x20, 
+	0x70, 0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 0x3d, 0x22, 0x5b, 
+	0x30, 0x2d, 0x39, 0x5d, 0x7b, 0x31, 0x2c, 0x33, 0x7d, 0x22, 
+	0x20, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3d, 0x22, 0x30, 0x20, 
+	0x2d, 0x20, 0x32, 0x35, 0x35, 0x22, 0x20, 0x3c, 0x21, 0x2d, 
+	0x2d, 0x23, 0x42, 0x38, 0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 
+	0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 
+	0x64, 0x3e, 0x2e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 
+	0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x69, 0x6e, 
+	0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 
+	0x69, 0x6e, 0x70, 0x75, 0x74, 0x22, 0x20, 0x6e, 0x61, 0x6d, 
+	0x65, 0x3d, 0x22, 0x42, 0x39, 0x22, 0x20, 0x73, 0x69, 0x7a, 
+	0x65, 0x3d, 0x22, 0x33, 0x22, 0x20, 0x70, 0x61, 0x74, 0x74, 
+	0x65, 0x72, 0x6e, 0x3d, 0x22, 0x5b, 0x30, 0x2d, 0x39, 0x5d, 
+	0x7b, 0x31, 0x2c, 0x33, 0x7d, 0x22, 0x20, 0x74, 0x69, 0x74, 
+	0x6c, 0x65, 0x3d, 0x22, 0x30, 0x20, 0x2d, 0x20, 0x32, 0x35, 
+	0x35, 0x22, 0x20, 0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x42, 0x39, 
 	0x2d, 0x2d, 0x3e, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 
 	0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x2e, 0x3c, 
 	0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 
 	0x74, 0x64, 0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 
 	0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 
 	0x74, 0x22, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 
-	0x31, 0x31, 0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 
+	0x31, 0x30, 0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 
 	0x33, 0x22, 0x20, 0x70, 0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 
 	0x3d, 0x22, 0x5b, 0x30, 0x2d, 0x39, 0x5d, 0x7b, 0x31, 0x2c, 
 	0x33, 0x7d, 0x22, 0x20, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3d, 
 	0x22, 0x30, 0x20, 0x2d, 0x20, 0x32, 0x35, 0x35, 0x22, 0x20, 
-	0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x42, 0x31, 0x31, 0x2d, 0x2d, 
+	0x3c, 0x21, 0x2d, 0x2d, 0x23, 0x42, 0x31, 0x30, 0x2d, 0x2d, 
 	0x3e, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 
-	0x9, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 
-	0x3c, 0x2f, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x3e, 0xd, 0xa, 
-	0x9, 0x9, 0x3c, 0x62, 0x72, 0x3e, 0x3c, 0x62, 0x72, 0x3e, 
-	0xd, 0xa, 0x9, 0x9, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 
-	0x20, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x3d, 0x22, 0x53, 0x65, 
-	0x74, 0x75, 0x70, 0x22, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 
-	0x22, 0x73, 0x75, 0x62, 0x6d, 0x69, 0x74, 0x22, 0x3e, 0xd, 
-	0xa, 0x9, 0x9, 0x3c, 0x62, 0x72, 0x3e, 0x3c, 0x62, 0x72, 
-	0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 0x2f, 0x66, 0x6f, 0x72, 
-	0x6d, 0x3e, 0xd, 0xa, 0x9, 0x3c, 0x2f, 0x62, 0x6f, 0x64, 
-	0x79, 0x3e, 0xd, 0xa, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 
-	0x3e, 0xd, 0xa, 0xd, 0xa, };
+	0x9, 0x9, 0x3c, 0x74, 0x64, 0x3e, 0x2e, 0x3c, 0x2f, 0x74, 
+	0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x9, 0x3c, 0x74, 0x64, 
+	0x3e, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 
+	0x70, 0x65, 0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x22, 
+	0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x42, 0x31, 0x31, 
+	0x22, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x22, 0x33, 0x22, 
+	0x20, 0x70, 0x61, 0x74, 0x74, 0x65, 0x72, 0x6e, 0x3d, 0x22, 
+	0x5b, 0x30, 0x2d, 0x39, 0x5d, 0x7b, 0x31, 0x2c, 0x33, 0x7d, 
+	0x22, 0x20, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3d, 0x22, 0x30, 
+	0x20, 0x2d, 0x20, 0x32, 0x35, 0x35, 0x22, 0x20, 0x3c, 0x21, 
+	0x2d, 0x2d, 0x23, 0x42, 0x31, 0x31, 0x2d, 0x2d, 0x3e, 0x3e, 
+	0x3c, 0x2f, 0x74, 0x64, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 
+	0x2f, 0x74, 0x72, 0x3e, 0xd, 0xa, 0x9, 0x9, 0x3c, 0x2f, 
+	0x74, 0x61, 0x62, 0x6c, 0x65, 0x3e, 0xd, 0xa, 0x9, 0x9, 
+	0x3c, 0x62, 0x72, 0x3e, 0x3c, 0x62, 0x72, 0x3e, 0xd, 0xa, 
+	0x9, 0x9, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x76, 
+	0x61, 0x6c, 0x75, 0x65, 0x3d, 0x22, 0x53, 0x65, 0x74, 0x75, 
+	0x70, 0x22, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x73, 
+	0x75, 0x62, 0x6d, 0x69, 0x74, 0x22, 0x3e, 0xd, 0xa, 0x9, 
+	0x9, 0x3c, 0x62, 0x72, 0x3e, 0x3c, 0x62, 0x72, 0x3e, 0xd, 
+	0xa, 0x9, 0x9, 0x3c, 0x2f, 0x66, 0x6f, 0x72, 0x6d, 0x3e, 
+	0xd, 0xa, 0x9, 0x3c, 0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 
+	0xd, 0xa, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0xd, 
+	0xa, 0xd, 0xa, };
 
 static const unsigned char data_done_html[] = {
 	/* /done.html */
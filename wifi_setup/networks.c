@@ -0,0 +1,304 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+
+#include "networks.h"
+
+/*
+ * Stored networks
+ *
+ * Up to NETWORKS_MAX networks are stored in flash (NETWORKS_KEY), each
+ * with a priority and the results of the last NETWORK_HISTORY_LEN
+ * connection attempts. The station ranks the networks found by a scan
+ * with them, see station.c.
+ * The list is kept in RAM and written back on every change, by a worker
+ * of the cyw43 async context (flash_commit_async()), so the callers never
+ * wait for the flash. Changes made before the worker runs are written
+ * together. A network that keeps connecting (or failing) does not change
+ * its history, so this costs no flash writes in the steady state.
+ */
+static network_list list;
+static bool loaded = false;
+
+static inline void list_lock()
+{
+    async_context_t *context = cyw43_arch_async_context();
+    if(context)
+        async_context_acquire_lock_blocking(context);
+}
+
+static inline void list_unlock()
+{
+    async_context_t *context = cyw43_arch_async_context();
+    if(context)
+        async_context_release_lock(context);
+}
+
+// Reads the list from flash once, the lock must be held
+static void load()
+{
+    uint16_t len;
+    const network_list *l;
+
+    if(loaded)
+        return;
+    l = (const network_list *)kv_get(NETWORKS_KEY, &len);
+    if(len == sizeof(network_list) && l->magic == MAGIC && l->count <= NETWORKS_MAX)
+        list = *l;
+    else{
+        memset(&list, 0, sizeof(list));
+        list.magic = 0;     // nothing stored, see networks_import()
+    }
+    loaded = true;
+}
+
+static void stored(flash_write_result result, void *arg)
+{
+    if(result == FLASH_WRITE_FAILED)
+        printf("ERROR: can not write the network list to flash\n");
+}
+
+// Writes the list to flash, the lock must be held
+static bool store()
+{
+    list.magic = MAGIC;
+    // the callers run in lwIP callbacks and the station worker
+    if(flash_commit_async(NETWORKS_KEY, &list, sizeof(list), stored, NULL))
+        return true;
+    if(kv_put(NETWORKS_KEY, &list, sizeof(list)) == FLASH_WRITE_FAILED){
+        stored(FLASH_WRITE_FAILED, NULL);
+        return false;
+    }
+    return true;
+}
+
+static int find(const char *ssid)
+{
+    for(int i = 0; i < list.count; i++){
+        if(strcmp(list.net[i].ssid, ssid) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/*
+ * networks_get()
+ *
+ * Copies up to "max" stored networks to "nets".
+ * Returns the number of networks copied.
+ */
+int networks_get(wifi_network *nets, int max)
+{
+    int n;
+
+    list_lock();
+    load();
+    n = list.count < max ? list.count : max;
+    memcpy(nets, list.net, n * sizeof(wifi_network));
+    list_unlock();
+    return n;
+}
+
+/*
+ * networks_add()
+ *
+ * Adds a network, or updates password, priority and security of a stored
+ * one ("auth" NETWORK_AUTH_UNKNOWN keeps the security stored).
+ * The history is kept, unless the password changed.
+ * Returns false if the list is full or the flash could not be written.
+ */
+bool networks_add(const char *ssid, const char *passwd, uint8_t priority, uint32_t auth)
+{
+    wifi_network *n;
+    bool ok = false;
+    int i;
+
+    if(*ssid == '\0')
+        return false;
+    if(priority > NETWORK_PRIORITY_MAX)
+        priority = NETWORK_PRIORITY_MAX;
+
+    list_lock();
+    load();
+    i = find(ssid);
+    if(i < 0 && list.count < NETWORKS_MAX){
+        i = list.count++;
+        memset(&list.net[i], 0, sizeof(wifi_network));
+        strncpy(list.net[i].ssid, ssid, SSID_MAX_LEN);
+        list.net[i].auth = NETWORK_AUTH_UNKNOWN;
+    }
+    if(i >= 0){
+        n = &list.net[i];
+        if(strncmp(n->passwd, passwd, PASSWD_MAX_LEN) != 0){
+            memset(n->passwd, 0, sizeof(n->passwd));
+            strncpy(n->passwd, passwd, PASSWD_MAX_LEN);
+            n->history = 0;
+            n->attempts = 0;
+        }
+        n->priority = priority;
+        if(auth != NETWORK_AUTH_UNKNOWN)
+            n->auth = auth;
+        ok = store();
+    }
+    list_unlock();
+    return ok;
+}
+
+/*
+ * networks_remove()
+ *
+ * Returns false if "ssid" is not stored or the flash could not be written.
+ */
+bool networks_remove(const char *ssid)
+{
+    bool ok = false;
+    int i;
+
+    list_lock();
+    load();
+    i = find(ssid);
+    if(i >= 0){
+        memmove(&list.net[i], &list.net[i + 1], (list.count - i - 1) * sizeof(wifi_network));
+        list.count--;
+        memset(&list.net[list.count], 0, sizeof(wifi_network));
+        ok = store();
+    }
+    list_unlock();
+    return ok;
+}
+
+/*
+ * networks_record()
+ *
+ * Adds the result of a connection attempt to the history of "ssid".
+ */
+void networks_record(const char *ssid, bool success)
+{
+    wifi_network *n;
+    uint8_t history;
+    int i;
+
+    list_lock();
+    load();
+    i = find(ssid);
+    if(i >= 0){
+        n = &list.net[i];
+        history = (n->history << 1) | (success ? 1 : 0);
+        if(history != n->history || n->attempts < NETWORK_HISTORY_LEN){
+            n->history = history;
+            if(n->attempts < NETWORK_HISTORY_LEN)
+                n->attempts++;
+            store();
+        }
+    }
+    list_unlock();
+}
+
+/*
+ * networks_set_auth()
+ *
+ * Stores the security of "ssid", a no-op if unchanged.
+ */
+void networks_set_auth(const char *ssid, uint32_t auth)
+{
+    int i;
+
+    list_lock();
+    load();
+    i = find(ssid);
+    if(i >= 0 && list.net[i].auth != auth){
+        list.net[i].auth = auth;
+        store();
+    }
+    list_unlock();
+}
+
+/*
+ * networks_auth()
+ *
+ * Returns the security to join an access point with, from the auth_mode
+ * of its scan result. The scan does not report WPA3: networks in WPA3
+ * transition mode also accept WPA2, pure WPA3 networks are not supported.
+ * Neither is WEP (NETWORK_AUTH_UNKNOWN).
+ */
+uint32_t networks_auth(uint8_t auth_mode)
+{
+    if((auth_mode & SCAN_AUTH_WPA2) && (auth_mode & SCAN_AUTH_WPA))
+        return CYW43_AUTH_WPA2_MIXED_PSK;
+    if(auth_mode & SCAN_AUTH_WPA2)
+        return CYW43_AUTH_WPA2_AES_PSK;
+    if(auth_mode & SCAN_AUTH_WPA)
+        return CYW43_AUTH_WPA_TKIP_PSK;
+    if(auth_mode == 0)
+        return CYW43_AUTH_OPEN;
+    return NETWORK_AUTH_UNKNOWN;
+}
+
+const char *networks_auth_name(uint32_t auth)
+{
+    switch(auth){
+        case CYW43_AUTH_OPEN:           return "open";
+        case CYW43_AUTH_WPA_TKIP_PSK:   return "WPA";
+        case CYW43_AUTH_WPA2_AES_PSK:   return "WPA2";
+        case CYW43_AUTH_WPA2_MIXED_PSK: return "WPA/WPA2";
+        default:                        return "unknown";
+    }
+}
+
+/*
+ * networks_import()
+ *
+ * Devices set up before the list existed only have the network of the
+ * configuration. It becomes the first entry, if no list was stored yet.
+ */
+void networks_import(const config *c)
+{
+    bool import;
+
+    list_lock();
+    load();
+    import = list.magic != MAGIC && c && c->magic == MAGIC
+             && *c->ssid != '\0' && (uint8_t)*c->ssid != 0xFF;
+    list_unlock();
+
+    if(import){
+        printf("Importing network \"%s\" into the list\n", c->ssid);
+        networks_add(c->ssid, c->passwd, 0, NETWORK_AUTH_UNKNOWN);
+    }
+}
+
+// Number of successful attempts in the history
+int networks_successes(const wifi_network *n)
+{
+    int s = 0;
+
+    for(int i = 0; i < n->attempts; i++)
+        s += (n->history >> i) & 1;
+    return s;
+}
+
+void networks_print()
+{
+    wifi_network nets[NETWORKS_MAX];
+    int n = networks_get(nets, NETWORKS_MAX);
+
+    printf("Stored networks: %d of %d\n", n, NETWORKS_MAX);
+    for(int i = 0; i < n; i++)
+        printf("\t\"%s\" %s, priority %u, %d of %u attempts successful\n", nets[i].ssid,
+               networks_auth_name(nets[i].auth), nets[i].priority,
+               networks_successes(&nets[i]), nets[i].attempts);
+}
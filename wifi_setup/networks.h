@@ -0,0 +1,65 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef NETWORKS_H
+#define NETWORKS_H
+
+#include "access_point.h"
+
+// The list of stored networks is stored under this key
+#define NETWORKS_KEY "networks"
+
+#ifndef NETWORKS_MAX
+#define NETWORKS_MAX 4
+#endif
+
+// Priorities range from 0 (default) to NETWORK_PRIORITY_MAX
+#define NETWORK_PRIORITY_MAX 9
+// Number of connection attempts kept in the history
+#define NETWORK_HISTORY_LEN  8
+// Security of a network not (yet) seen by a scan
+#define NETWORK_AUTH_UNKNOWN 0xFFFFFFFF
+
+// auth_mode bits of a scan result
+#define SCAN_AUTH_WEP   0x01
+#define SCAN_AUTH_WPA   0x02
+#define SCAN_AUTH_WPA2  0x04
+
+typedef struct _wifi_network {
+    char    ssid[SSID_MAX_LEN + 1];
+    char    passwd[PASSWD_MAX_LEN + 1];
+    uint8_t priority;
+    uint8_t history;    // bit 0 is the latest attempt, 1: success
+    uint8_t attempts;   // valid bits in history
+    uint32_t auth;      // CYW43_AUTH_..., detected by a scan
+} wifi_network;
+
+typedef struct _network_list {
+    uint16_t     magic;     // MAGIC
+    uint16_t     count;
+    wifi_network net[NETWORKS_MAX];
+} network_list;
+
+static_assert(sizeof(network_list) <= FLASH_RECORD_MAX_LEN, "network list too large for flash");
+
+int networks_get(wifi_network *nets, int max);
+bool networks_add(const char *ssid, const char *passwd, uint8_t priority, uint32_t auth);
+void networks_set_auth(const char *ssid, uint32_t auth);
+uint32_t networks_auth(uint8_t auth_mode);
+const char *networks_auth_name(uint32_t auth);
+bool networks_remove(const char *ssid);
+void networks_record(const char *ssid, bool success);
+void networks_import(const config *c);
+int networks_successes(const wifi_network *n);
+void networks_print();
+
+#endif // NETWORKS_H
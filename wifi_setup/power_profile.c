@@ -0,0 +1,140 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+
+#include "access_point.h"
+#include "power_profile.h"
+
+/*
+ * Power management profiles
+ *
+ * The profile sets when the Wi-Fi chip may sleep between beacons. The
+ * less it sleeps, the lower and steadier the latency and the higher the
+ * current.
+ *
+ *   max-performance  radio always on
+ *   balanced         PM2: stays awake for 50 ms after the last packet
+ *   power-save       PM1: sleeps right after every packet, buffered
+ *                    packets are fetched after the next beacon
+ *   default          CYW43_DEFAULT_PM, whatever the SDK sets (currently
+ *                    PM2, awake for 200 ms after the last packet)
+ *
+ * The profile is stored in flash and applied by the station after
+ * every association (see station.c).
+ * Use linux/pm_bench to measure the trade-off in your network.
+ */
+typedef struct _power_record {
+    uint16_t magic;     // MAGIC
+    uint16_t profile;
+} power_record;
+
+static const char *profile_names[POWER_PROFILES] = {
+    "default",
+    "max-performance",
+    "balanced",
+    "power-save",
+};
+
+static uint32_t pm_value(power_profile profile)
+{
+    switch(profile){
+        case POWER_MAX_PERFORMANCE:
+            return cyw43_pm_value(CYW43_NO_POWERSAVE_MODE, 10, 0, 0, 0);
+        case POWER_BALANCED:
+            // CYW43_DEFAULT_PM, but back to sleep 4 times sooner
+            return cyw43_pm_value(CYW43_PM2_POWERSAVE_MODE, 50, 1, 1, 10);
+        case POWER_SAVE:
+            return cyw43_pm_value(CYW43_PM1_POWERSAVE_MODE, 10, 0, 0, 0);
+        default:
+            return CYW43_DEFAULT_PM;
+    }
+}
+
+// The profile set last, until it is in flash (see flash_commit_async())
+static power_record pending;
+
+static void stored(flash_write_result result, void *arg)
+{
+    if(result == FLASH_WRITE_FAILED)
+        printf("ERROR: can not store the power profile\n");
+}
+
+// Returns the stored profile, POWER_DEFAULT if there is none
+power_profile power_profile_get()
+{
+    uint16_t len;
+    const power_record *r = &pending;
+
+    if(r->magic != MAGIC)
+        r = (const power_record *)kv_get(POWER_PROFILE_KEY, &len);
+    else
+        len = sizeof(pending);
+    if(len < sizeof(power_record) || r->magic != MAGIC || r->profile >= POWER_PROFILES)
+        return POWER_DEFAULT;
+    return (power_profile)r->profile;
+}
+
+/*
+ * power_profile_set()
+ *
+ * Stores "profile" and applies it at once, if the station is associated.
+ * It is written to flash later by a worker, this can be called from an
+ * lwIP callback.
+ * Returns false if the profile is unknown.
+ */
+bool power_profile_set(power_profile profile)
+{
+    if(profile >= POWER_PROFILES)
+        return false;
+    pending.magic = MAGIC;
+    pending.profile = profile;
+    if(!flash_commit_async(POWER_PROFILE_KEY, &pending, sizeof(pending), stored, NULL)
+       && kv_put(POWER_PROFILE_KEY, &pending, sizeof(pending)) == FLASH_WRITE_FAILED){
+        stored(FLASH_WRITE_FAILED, NULL);
+        pending.magic = 0;
+        return false;
+    }
+    if(cyw43_wifi_link_status(&cyw43_state, CYW43_ITF_STA) == CYW43_LINK_JOIN)
+        power_profile_apply();
+    return true;
+}
+
+// Applies the stored profile, call after the association
+void power_profile_apply()
+{
+    power_profile profile = power_profile_get();
+
+    if(cyw43_wifi_pm(&cyw43_state, pm_value(profile)) != 0)
+        printf("Can not set power profile %s\n", profile_names[profile]);
+    else
+        DEBUG_printf("Power profile: %s\n", profile_names[profile]);
+}
+
+const char *power_profile_name(power_profile profile)
+{
+    return profile < POWER_PROFILES ? profile_names[profile] : "?";
+}
+
+// Returns the profile called "name", -1 if there is none
+int power_profile_parse(const char *name)
+{
+    for(int i = 0; i < POWER_PROFILES; i++){
+        if(strcmp(profile_names[i], name) == 0)
+            return i;
+    }
+    return -1;
+}
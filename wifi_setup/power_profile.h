@@ -0,0 +1,36 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef POWER_PROFILE_H
+#define POWER_PROFILE_H
+
+#include <stdbool.h>
+
+// The selected profile is stored under this key
+#define POWER_PROFILE_KEY "power_profile"
+
+// Power management of the Wi-Fi chip in station mode, see power_profile.c
+typedef enum _power_profile {
+    POWER_DEFAULT,          // as set by the SDK (CYW43_DEFAULT_PM)
+    POWER_MAX_PERFORMANCE,  // no power saving
+    POWER_BALANCED,         // PM2, 50 ms
+    POWER_SAVE,             // PM1
+    POWER_PROFILES
+} power_profile;
+
+power_profile power_profile_get();
+bool power_profile_set(power_profile profile);
+void power_profile_apply();
+const char *power_profile_name(power_profile profile);
+int power_profile_parse(const char *name);
+
+#endif // POWER_PROFILE_H
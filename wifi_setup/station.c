@@ -0,0 +1,699 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "pico/rand.h"
+
+#include "lwipopts.h"
+#include "lwip/etharp.h"
+#if LWIP_DHCP
+#include "lwip/dhcp.h"
+#include "lwip/dns.h"
+#include "lwip/prot/dhcp.h"
+#endif
+
+#include "networks.h"
+#include "power_profile.h"
+#include "station.h"
+#include "timeline.h"
+
+/*
+ * Connecting to one of the stored networks
+ *
+ * After a successful connection, the BSSID, channel and security of the
+ * access point are stored in flash (WIFI_CACHE_KEY). At the next boot the
+ * join is directed to this access point on this channel, which saves the
+ * scan. If this does not succeed within STATION_FAST_TIMEOUT_MS (e.g. the
+ * access point was replaced, moved to another channel or the device was
+ * moved to another place), all channels are scanned once.
+ * The stored networks found by the scan are ranked by their RSSI, priority
+ * and history (see rank()) and tried in this order, each for
+ * STATION_CANDIDATE_TIMEOUT_MS. The result of every attempt is added to
+ * the history of the network.
+ *
+ * The connection is kept up by a state machine, run by a worker of the
+ * cyw43 async context (see station_start()):
+ *
+ *   JOINING   directed join to the cached access point or a scanned one
+ *   SCANNING  scan of all channels
+ *   DHCP      associated, waiting for an address
+ *   UP        connected
+ *   BACKOFF   waiting before the next attempt
+ *
+ * The worker polls the link while joining, is woken by the netif link and
+ * status callbacks and otherwise only checks the link every
+ * STATION_SUPERVISE_MS. A lost link is joined again at once, failed
+ * attempts are repeated after a random delay that doubles with each
+ * failure (STATION_BACKOFF_MIN_MS to STATION_BACKOFF_MAX_MS).
+ * Nothing blocks, the application keeps running meanwhile.
+ */
+
+// Returns the access point of the last connection, NULL if there is none
+static const wifi_cache *cache_get()
+{
+    uint16_t len;
+    const wifi_cache *wc = (const wifi_cache *)kv_get(WIFI_CACHE_KEY, &len);
+
+    if(len < sizeof(wifi_cache) || wc->magic != MAGIC)
+        return NULL;
+    return wc;
+}
+
+// Written by flash_commit_async(), the station runs in a worker
+static wifi_cache cache;
+
+static void cache_stored(flash_write_result result, void *arg)
+{
+    if(result == FLASH_WRITE_FAILED)
+        DEBUG_printf("Can not store the %s\n", (const char *)arg);
+}
+
+// Stores the access point we are associated with, a no-op if unchanged
+static void cache_update(const char *ssid, uint32_t auth)
+{
+    wifi_cache wc;
+    uint32_t channel[3];    // hw, target and scan channel
+
+    memset(&wc, 0, sizeof(wc));
+    wc.magic = MAGIC;
+    strncpy(wc.ssid, ssid, SSID_MAX_LEN);
+    wc.auth = auth;
+    if(cyw43_wifi_get_bssid(&cyw43_state, wc.bssid) != 0)
+        return;
+    if(cyw43_ioctl(&cyw43_state, CYW43_IOCTL_GET_CHANNEL, sizeof(channel),
+                   (uint8_t *)channel, CYW43_ITF_STA) != 0)
+        return;
+    wc.channel = channel[0];
+
+    cache = wc;
+    if(!flash_commit_async(WIFI_CACHE_KEY, &cache, sizeof(cache), cache_stored, "access point")
+       && kv_put(WIFI_CACHE_KEY, &cache, sizeof(cache)) == FLASH_WRITE_FAILED)
+        cache_stored(FLASH_WRITE_FAILED, "access point");
+}
+
+#if LWIP_DHCP
+/*
+ * DHCP lease
+ *
+ * After the station got an address by DHCP, the lease is stored in flash
+ * (DHCP_LEASE_KEY). At the next boot station_lease_restore() sets the
+ * interface up with this address at once and puts the DHCP client into
+ * the REBOOTING state. When the link comes up, lwIP sends an INIT-REBOOT
+ * REQUEST for this address instead of starting with a DISCOVER. The
+ * server confirms it with an ACK, which renews the lease, or declines
+ * with a NAK, upon which lwIP removes the address and starts over.
+ *
+ * The Pico-W has no real time clock, so the time spent switched off is
+ * unknown. A lease that had expired or passed T1 (half its time) when it
+ * was stored is not used, otherwise whether it is still valid is left to
+ * the server.
+ */
+#define DHCP_COARSE_S 60   // DHCP_COARSE_TIMER_SECS, unit of lease_used
+
+static dhcp_lease lease;   // written by flash_commit_async()
+
+/*
+ * Stores the lease the DHCP client is bound to, a no-op if unchanged.
+ * Returns false if the client is not (yet) bound.
+ */
+static bool lease_store(const char *ssid)
+{
+    struct netif *netif = &cyw43_state.netif[CYW43_ITF_STA];
+    struct dhcp *dhcp = netif_dhcp_data(netif);
+    dhcp_lease l;
+
+    if(!dhcp || !dhcp_supplied_address(netif))
+        return false;
+
+    memset(&l, 0, sizeof(l));
+    l.magic = MAGIC;
+    l.ip = dhcp->offered_ip_addr;
+    l.mask = dhcp->offered_sn_mask;
+    l.gw = dhcp->offered_gw_addr;
+    l.server = *ip_2_ip4(&dhcp->server_ip_addr);
+    const ip_addr_t *dns = dns_getserver(0);
+    if(dns)
+        l.dns = *ip_2_ip4(dns);
+    l.lease_s = dhcp->offered_t0_lease;
+    strncpy(l.ssid, ssid, SSID_MAX_LEN);
+    uint32_t used = dhcp->lease_used * DHCP_COARSE_S;
+    l.remaining_s = l.lease_s > used ? l.lease_s - used : 0;
+
+    // Not rewritten just because the remaining time differs, as long as
+    // the stored one still passes the T1 check of station_lease_restore()
+    uint16_t len = sizeof(lease);
+    const dhcp_lease *old = &lease;     // the last one written, or pending
+    if(old->magic != MAGIC)
+        old = (const dhcp_lease *)kv_get(DHCP_LEASE_KEY, &len);
+    if(len == sizeof(l) && old->remaining_s >= l.lease_s / 2){
+        dhcp_lease cmp = l;
+        cmp.remaining_s = old->remaining_s;
+        if(memcmp(old, &cmp, sizeof(cmp)) == 0)
+            return true;
+    }
+
+    lease = l;
+    if(!flash_commit_async(DHCP_LEASE_KEY, &lease, sizeof(lease), cache_stored, "DHCP lease")
+       && kv_put(DHCP_LEASE_KEY, &lease, sizeof(lease)) == FLASH_WRITE_FAILED)
+        cache_stored(FLASH_WRITE_FAILED, "DHCP lease");
+    return true;
+}
+
+/*
+ * The address may be in use before the server has answered the
+ * INIT-REBOOT REQUEST, so a worker waits for the client to be bound.
+ */
+#define LEASE_POLL_MS   500
+#define LEASE_POLLS     120
+
+static struct {
+    async_at_time_worker_t worker;
+    char ssid[SSID_MAX_LEN + 1];
+    int  polls;
+} lease_watch;
+
+static void lease_work(async_context_t *context, async_at_time_worker_t *worker)
+{
+    if(lease_store(lease_watch.ssid))
+        return;
+    if(++lease_watch.polls < LEASE_POLLS)
+        async_context_add_at_time_worker_in_ms(context, worker, LEASE_POLL_MS);
+}
+
+static void lease_watch_start(const char *ssid)
+{
+    async_context_t *context = cyw43_arch_async_context();
+    struct dhcp *dhcp = netif_dhcp_data(&cyw43_state.netif[CYW43_ITF_STA]);
+
+    if(!dhcp || dhcp->state == DHCP_STATE_OFF)
+        return;     // static IP
+    async_context_acquire_lock_blocking(context);
+    async_context_remove_at_time_worker(context, &lease_watch.worker);
+    strncpy(lease_watch.ssid, ssid, SSID_MAX_LEN);
+    lease_watch.polls = 0;
+    lease_watch.worker.do_work = lease_work;
+    async_context_add_at_time_worker_in_ms(context, &lease_watch.worker, 0);
+    async_context_release_lock(context);
+}
+
+/*
+ * station_lease_restore()
+ *
+ * Call after cyw43_arch_enable_sta_mode() and before station_start().
+ * Returns true if a lease was found for the network of the cached access
+ * point, which is tried first.
+ */
+bool station_lease_restore()
+{
+    uint16_t len;
+    const dhcp_lease *l = (const dhcp_lease *)kv_get(DHCP_LEASE_KEY, &len);
+    const wifi_cache *wc = cache_get();
+    struct netif *netif = &cyw43_state.netif[CYW43_ITF_STA];
+
+    if(len < sizeof(dhcp_lease) || l->magic != MAGIC || !wc || strcmp(l->ssid, wc->ssid) != 0)
+        return false;
+    // expired, or past T1 (half the lease) when it was stored
+    if(l->remaining_s == 0 || l->remaining_s < l->lease_s / 2){
+        printf("Stored DHCP lease too old (%lu of %lu s left), not used\n",
+               (unsigned long)l->remaining_s, (unsigned long)l->lease_s);
+        return false;
+    }
+
+    cyw43_arch_lwip_begin();
+    struct dhcp *dhcp = netif_dhcp_data(netif);
+    if(dhcp){
+        netif_set_addr(netif, &l->ip, &l->mask, &l->gw);
+        if(!ip4_addr_isany_val(l->dns))
+            dns_setserver(0, (const ip_addr_t *)&l->dns);
+        dhcp->offered_ip_addr = l->ip;
+        dhcp->offered_sn_mask = l->mask;
+        dhcp->offered_gw_addr = l->gw;
+        dhcp->tries = 0;
+        // dhcp_network_changed() sends the INIT-REBOOT REQUEST on link up
+        dhcp->state = DHCP_STATE_REBOOTING;
+    }
+    cyw43_arch_lwip_end();
+
+    if(!dhcp)
+        return false;
+    printf("Using stored DHCP lease: %s (%lu s left when stored)\n",
+           ip4addr_ntoa(&l->ip), (unsigned long)l->remaining_s);
+    return true;
+}
+#else
+bool station_lease_restore()
+{
+    return false;
+}
+#endif // LWIP_DHCP
+
+#define STATION_POLL_MS         50      // while joining
+#define STATION_SCAN_TIMEOUT_MS 10000
+#define STATION_DHCP_TIMEOUT_MS 10000
+
+static const char *state_names[] = {
+    "stopped", "joining", "scanning", "DHCP", "up", "backoff"
+};
+
+// A stored network, found by the scan
+typedef struct _candidate {
+    bool     seen;
+    int      score;
+    int16_t  rssi;                  // of the strongest access point
+    uint8_t  bssid[6];
+    uint16_t channel;
+    uint8_t  auth_mode;
+    const wifi_network *net;
+} candidate;
+
+static struct {
+    async_at_time_worker_t worker;
+    station_state   state;
+    absolute_time_t deadline;       // of the current state
+    wifi_network    nets[NETWORKS_MAX];
+    int             nnets;
+    candidate       scan[NETWORKS_MAX];  // indexed like nets
+    candidate      *ranked[NETWORKS_MAX];
+    int             nranked;
+    int             next;           // in ranked
+    const wifi_network *net;        // of the current attempt
+    uint32_t        auth;
+    bool            cached;         // directed join to the cached access point
+    bool            static_ip;      // see station_static_ip()
+    station_state_cb callback;
+    void           *arg;
+    int             failures;       // consecutive failed attempts
+    uint64_t        attempt_start;  // time_us_64()
+    uint64_t        scan_start;     // 0: not scanned
+} sta;
+
+// (Re)schedules the worker, the lock is held
+static void schedule(uint32_t ms)
+{
+    async_context_t *context = cyw43_arch_async_context();
+    async_context_remove_at_time_worker(context, &sta.worker);
+    async_context_add_at_time_worker_in_ms(context, &sta.worker, ms);
+}
+
+static void set_state(station_state state, uint32_t timeout_ms, uint32_t poll_ms)
+{
+    station_state old = sta.state;
+
+    sta.state = state;
+    sta.deadline = make_timeout_time_ms(timeout_ms);
+    if(state != STATION_STOPPED)
+        schedule(poll_ms);
+    DEBUG_printf("Station: %s -> %s\n", state_names[old], state_names[state]);
+    if(sta.callback && old != state)
+        sta.callback(old, state, sta.arg);
+}
+
+static inline bool timed_out()
+{
+    return absolute_time_diff_us(get_absolute_time(), sta.deadline) < 0;
+}
+
+// Waits for the next attempt, the delay is doubled with each failure
+static void backoff()
+{
+    uint32_t delay = STATION_BACKOFF_MIN_MS;
+
+    cyw43_wifi_leave(&cyw43_state, CYW43_ITF_STA);
+    for(int i = 1; i < sta.failures && delay < STATION_BACKOFF_MAX_MS; i++)
+        delay *= 2;
+    if(delay > STATION_BACKOFF_MAX_MS)
+        delay = STATION_BACKOFF_MAX_MS;
+    // half of it random, so that devices do not retry in step
+    delay = delay / 2 + get_rand_32() % (delay / 2 + 1);
+
+    DEBUG_printf("Station: attempt %d failed, next one in %lu ms\n",
+                 sta.failures, (unsigned long)delay);
+    set_state(STATION_BACKOFF, delay, delay);
+}
+
+static void fail()
+{
+    sta.failures++;
+    backoff();
+}
+
+static bool join(const wifi_network *n, uint32_t auth, const uint8_t *bssid, uint32_t channel)
+{
+    const char *pw = *n->passwd ? n->passwd : NULL;
+
+    if(auth == NETWORK_AUTH_UNKNOWN)
+        auth = CYW43_AUTH_WPA2_AES_PSK;
+    if(!pw || auth == CYW43_AUTH_OPEN){
+        pw = NULL;
+        auth = CYW43_AUTH_OPEN;
+    }
+    sta.net = n;
+    sta.auth = auth;
+    return cyw43_wifi_join(&cyw43_state, strlen(n->ssid), (const uint8_t *)n->ssid,
+                           pw ? strlen(pw) : 0, (const uint8_t *)pw,
+                           sta.auth, bssid, channel) == 0;
+}
+
+// Tries the next network found by the scan, fails if there is none left
+static void next_candidate()
+{
+    while(sta.next < sta.nranked){
+        candidate *c = sta.ranked[sta.next++];
+
+        uint32_t auth = networks_auth(c->auth_mode);
+
+        printf("Trying \"%s\" (%d dBm, channel %u, %s)\n", c->net->ssid, c->rssi,
+               c->channel, networks_auth_name(auth));
+        // the security of the access point may have changed
+        if(auth != NETWORK_AUTH_UNKNOWN && auth != c->net->auth)
+            networks_set_auth(c->net->ssid, auth);
+        if(join(c->net, auth, c->bssid, c->channel)){
+            set_state(STATION_JOINING, STATION_CANDIDATE_TIMEOUT_MS, STATION_POLL_MS);
+            return;
+        }
+        networks_record(c->net->ssid, false);
+    }
+    fail();
+}
+
+// Called for every access point found, in the context of the cyw43 driver
+static int scan_result(void *env, const cyw43_ev_scan_result_t *result)
+{
+    for(int i = 0; i < sta.nnets; i++){
+        candidate *c = &sta.scan[i];
+
+        if(result->ssid_len != strlen(sta.nets[i].ssid)
+           || memcmp(result->ssid, sta.nets[i].ssid, result->ssid_len) != 0)
+            continue;
+        if(!c->seen || result->rssi > c->rssi){
+            c->seen = true;
+            c->rssi = result->rssi;
+            memcpy(c->bssid, result->bssid, sizeof(c->bssid));
+            c->channel = result->channel;
+            c->auth_mode = result->auth_mode;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Ranks the networks found: RSSI in dBm, plus STATION_PRIORITY_DB per
+ * priority level and STATION_HISTORY_DB per successful, minus per failed
+ * attempt of the history.
+ */
+static void rank()
+{
+    sta.nranked = 0;
+    sta.next = 0;
+    for(int i = 0; i < sta.nnets; i++){
+        candidate *c = &sta.scan[i];
+        const wifi_network *n = &sta.nets[i];
+
+        if(!c->seen)
+            continue;
+        int ok = networks_successes(n);
+        c->net = n;
+        c->score = c->rssi + n->priority * STATION_PRIORITY_DB
+                   + (2 * ok - n->attempts) * STATION_HISTORY_DB;
+
+        // insertion sort, best first
+        int j = sta.nranked++;
+        for(; j > 0 && sta.ranked[j - 1]->score < c->score; j--)
+            sta.ranked[j] = sta.ranked[j - 1];
+        sta.ranked[j] = c;
+    }
+    printf("Scan: %d of %d stored networks found\n", sta.nranked, sta.nnets);
+}
+
+static void start_scan()
+{
+    cyw43_wifi_scan_options_t opts;
+
+    memset(&opts, 0, sizeof(opts));
+    memset(sta.scan, 0, sizeof(sta.scan));
+    sta.cached = false;
+    sta.scan_start = time_us_64();
+    if(cyw43_wifi_scan(&cyw43_state, &opts, NULL, scan_result) != 0)
+        fail();
+    else
+        set_state(STATION_SCANNING, STATION_SCAN_TIMEOUT_MS, STATION_POLL_MS);
+}
+
+// Starts a connection attempt, with the cached access point if there is one
+static void start_attempt()
+{
+    const wifi_cache *wc = cache_get();
+
+    // the list may have been changed meanwhile
+    sta.nnets = networks_get(sta.nets, NETWORKS_MAX);
+    sta.attempt_start = time_us_64();
+    sta.scan_start = 0;
+    if(sta.nnets == 0){
+        printf("No network stored\n");
+        fail();
+        return;
+    }
+
+    if(wc){
+        for(int i = 0; i < sta.nnets; i++){
+            if(strcmp(sta.nets[i].ssid, wc->ssid) == 0 &&
+               join(&sta.nets[i], sta.nets[i].auth != NETWORK_AUTH_UNKNOWN ?
+                    sta.nets[i].auth : wc->auth, wc->bssid, wc->channel)){
+                sta.cached = true;
+                set_state(STATION_JOINING, STATION_FAST_TIMEOUT_MS, STATION_POLL_MS);
+                return;
+            }
+        }
+    }
+    start_scan();
+}
+
+// The current attempt failed, tries the next network
+static void attempt_failed()
+{
+    cyw43_wifi_leave(&cyw43_state, CYW43_ITF_STA);
+    if(sta.cached){
+        DEBUG_printf("Cached access point not found, scanning\n");
+        start_scan();
+        return;
+    }
+    networks_record(sta.net->ssid, false);
+    next_candidate();
+}
+
+static void up()
+{
+    uint64_t now = time_us_64();
+
+    if(sta.scan_start){
+        printf("Connected to \"%s\" via scan in %lu ms (%lu ms after boot)\n", sta.net->ssid,
+               (unsigned long)((now - sta.scan_start) / 1000), (unsigned long)(now / 1000));
+        if(sta.scan_start != sta.attempt_start)
+            printf("\t%lu ms lost trying the cached access point\n",
+                   (unsigned long)((sta.scan_start - sta.attempt_start) / 1000));
+        cache_update(sta.net->ssid, sta.auth);
+    }
+    else
+        printf("Connected to \"%s\" via cached access point in %lu ms (%lu ms after boot)\n",
+               sta.net->ssid, (unsigned long)((now - sta.attempt_start) / 1000),
+               (unsigned long)(now / 1000));
+
+    timeline_mark(TIMELINE_DHCP_BOUND);
+    networks_record(sta.net->ssid, true);
+    sta.failures = 0;
+    set_state(STATION_UP, 0, STATION_SUPERVISE_MS);
+#if LWIP_DHCP
+    lease_watch_start(sta.net->ssid);
+#endif
+}
+
+// Associated with the access point
+static void associated()
+{
+    struct netif *netif = &cyw43_state.netif[CYW43_ITF_STA];
+
+    timeline_mark(TIMELINE_ASSOCIATED);
+    power_profile_apply();
+    if(!sta.static_ip){
+        set_state(STATION_DHCP, STATION_DHCP_TIMEOUT_MS, 0);
+        return;
+    }
+    // The address is valid at once, tell the neighbours (their ARP
+    // caches may still hold another device for it)
+    if(netif_is_link_up(netif))
+        etharp_gratuitous(netif);
+    up();
+}
+
+static void station_work(async_context_t *context, async_at_time_worker_t *worker)
+{
+    int link = cyw43_wifi_link_status(&cyw43_state, CYW43_ITF_STA);
+
+    switch(sta.state){
+        case STATION_JOINING:
+            if(link == CYW43_LINK_JOIN)
+                associated();
+            else if(link < 0 || timed_out()){
+                DEBUG_printf("Join of \"%s\" failed (%d)\n", sta.net->ssid, link);
+                attempt_failed();
+            }
+            else
+                schedule(STATION_POLL_MS);
+            break;
+
+        case STATION_SCANNING:
+            if(!cyw43_wifi_scan_active(&cyw43_state)){
+                rank();
+                next_candidate();
+            }
+            else if(timed_out())
+                fail();
+            else
+                schedule(STATION_POLL_MS);
+            break;
+
+        case STATION_DHCP:
+            if(link != CYW43_LINK_JOIN || timed_out())
+                attempt_failed();
+            else if(cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA) == CYW43_LINK_UP)
+                up();
+            else
+                schedule(STATION_POLL_MS);  // woken by the status callback
+            break;
+
+        case STATION_UP:
+            if(link != CYW43_LINK_JOIN){
+                printf("Wi-Fi connection lost, reconnecting\n");
+                cyw43_wifi_leave(&cyw43_state, CYW43_ITF_STA);
+                start_attempt();
+            }
+            else
+                schedule(STATION_SUPERVISE_MS);
+            break;
+
+        case STATION_BACKOFF:
+            start_attempt();
+            break;
+
+        default:
+            break;
+    }
+}
+
+// netif callbacks, they wake the worker
+static void station_netif_changed(struct netif *netif)
+{
+    if(sta.state == STATION_DHCP || sta.state == STATION_UP)
+        schedule(0);
+}
+
+/*
+ * station_static_ip()
+ *
+ * Sets the static address of "c" on the interface and stops the DHCP
+ * client started by cyw43_arch_enable_sta_mode(). Without a link it has
+ * not sent anything yet. The station then skips the DHCP state: the
+ * address is used as soon as the link is up and announced by a
+ * gratuitous ARP.
+ * Call after cyw43_arch_enable_sta_mode() and before station_start().
+ */
+void station_static_ip(const config *c)
+{
+    struct netif *netif = &cyw43_state.netif[CYW43_ITF_STA];
+
+    cyw43_arch_lwip_begin();
+#if LWIP_DHCP
+    dhcp_release_and_stop(netif);
+#endif
+    netif_set_addr(netif, &c->ip, &c->mask, &c->gw);
+    netif_set_up(netif);
+    cyw43_arch_lwip_end();
+    sta.static_ip = true;
+}
+
+/*
+ * station_start()
+ *
+ * Starts connecting to one of the stored networks (see networks.c) in the
+ * background and keeps the connection up.
+ * "callback" (may be NULL) is called on every change of the state, in the
+ * context of the lwIP callbacks: it must not block.
+ * Call cyw43_arch_enable_sta_mode() and set up the IP address first.
+ */
+void station_start(station_state_cb callback, void *arg)
+{
+    async_context_t *context = cyw43_arch_async_context();
+    struct netif *netif = &cyw43_state.netif[CYW43_ITF_STA];
+
+    async_context_acquire_lock_blocking(context);
+    sta.callback = callback;
+    sta.arg = arg;
+    sta.failures = 0;
+    sta.worker.do_work = station_work;
+
+    netif_set_link_callback(netif, station_netif_changed);
+    netif_set_status_callback(netif, station_netif_changed);
+    start_attempt();
+    async_context_release_lock(context);
+}
+
+/*
+ * station_stop()
+ *
+ * Stops the state machine and leaves the network.
+ */
+void station_stop()
+{
+    async_context_t *context = cyw43_arch_async_context();
+
+    async_context_acquire_lock_blocking(context);
+    async_context_remove_at_time_worker(context, &sta.worker);
+    cyw43_wifi_leave(&cyw43_state, CYW43_ITF_STA);
+    set_state(STATION_STOPPED, 0, 0);
+    sta.static_ip = false;
+    async_context_release_lock(context);
+}
+
+station_state station_get_state()
+{
+    return sta.state;
+}
+
+const char *station_state_name(station_state state)
+{
+    return state < sizeof(state_names) / sizeof(state_names[0]) ? state_names[state] : "?";
+}
+
+/*
+ * station_wait()
+ *
+ * Waits until the station is up, as cyw43_arch_wifi_connect_timeout_ms()
+ * does. "abort" (may be NULL) is polled meanwhile.
+ * Returns 0, STATION_ABORTED if "abort" returned true, or
+ * PICO_ERROR_TIMEOUT. The state machine keeps running in the last case.
+ */
+int station_wait(uint32_t timeout_ms, bool (*abort)(void))
+{
+    absolute_time_t until = make_timeout_time_ms(timeout_ms);
+
+    while(sta.state != STATION_UP){
+        if(abort && abort())
+            return STATION_ABORTED;
+        if(absolute_time_diff_us(get_absolute_time(), until) < 0)
+            return PICO_ERROR_TIMEOUT;
+        sleep_ms(1);
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STATION_H
+#define STATION_H
+
+#include "access_point.h"
+
+// The access point of the last connection is stored under this key
+#define WIFI_CACHE_KEY "wifi_cache"
+
+// Time to wait for the association with the cached access point,
+// before a full scan is done
+#define STATION_FAST_TIMEOUT_MS 3000
+// Time to wait for the association with each network found by the scan
+#define STATION_CANDIDATE_TIMEOUT_MS 5000
+// Ranking of the networks found: the RSSI in dBm plus this per priority level
+#define STATION_PRIORITY_DB 10
+// and this per successful, minus per failed attempt of the history
+#define STATION_HISTORY_DB  3
+
+// The access point of the last successful connection
+typedef struct _wifi_cache {
+    uint16_t magic;                 // MAGIC
+    uint8_t  bssid[6];
+    uint32_t channel;
+    uint32_t auth;
+    char     ssid[SSID_MAX_LEN + 1]; // the cache is only used for this network
+} wifi_cache;
+
+// The DHCP lease of the station is stored under this key
+#define DHCP_LEASE_KEY "dhcp_lease"
+
+typedef struct _dhcp_lease {
+    uint16_t   magic;                   // MAGIC
+    ip4_addr_t ip;
+    ip4_addr_t mask;
+    ip4_addr_t gw;
+    ip4_addr_t dns;
+    ip4_addr_t server;
+    uint32_t   lease_s;                 // lease time granted by the server
+    uint32_t   remaining_s;             // left when it was stored
+    char       ssid[SSID_MAX_LEN + 1];  // the lease is only used in this network
+} dhcp_lease;
+
+// Check of the link while connected
+#define STATION_SUPERVISE_MS    5000
+// Delay after the first failed attempt, doubled with each further one
+#define STATION_BACKOFF_MIN_MS  1000
+#define STATION_BACKOFF_MAX_MS  60000
+
+// States of the connection, see station.c
+typedef enum _station_state {
+    STATION_STOPPED,
+    STATION_JOINING,
+    STATION_SCANNING,
+    STATION_DHCP,
+    STATION_UP,
+    STATION_BACKOFF
+} station_state;
+
+// Called by the state machine on every change of the state
+typedef void (*station_state_cb)(station_state from, station_state to, void *arg);
+
+// Returned by station_wait(), if "abort" returned true
+#define STATION_ABORTED 1
+
+void station_start(station_state_cb callback, void *arg);
+void station_stop();
+int station_wait(uint32_t timeout_ms, bool (*abort)(void));
+station_state station_get_state();
+const char *station_state_name(station_state state);
+bool station_lease_restore();
+void station_static_ip(const config *c);
+
+#endif // STATION_H
@@ -0,0 +1,102 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+
+#include "timeline.h"
+
+/*
+ * A phase is written once, with a single 32 bit store, so it may be
+ * marked in interrupt context (e.g. by the station state machine)
+ * without locking. 0 means not reached.
+ */
+static volatile uint32_t marks[TIMELINE_PHASES];
+
+static const char *phase_names[TIMELINE_PHASES] = {
+    "main",
+    "stdio_init",
+    "cyw43_init",
+    "flash_read",
+    "force_setup",
+    "ap_start",
+    "associated",
+    "dhcp_bound",
+    "tcp_listen",
+};
+
+/*
+ * timeline_mark()
+ *
+ * Records the current time for "phase", unless it was reached before.
+ */
+void timeline_mark(timeline_phase phase)
+{
+    uint32_t now = time_us_32();
+
+    if(phase < TIMELINE_PHASES && !marks[phase])
+        marks[phase] = now ? now : 1;
+}
+
+// Returns the time (us since boot) "phase" was reached, 0 if not yet
+uint32_t timeline_get(timeline_phase phase)
+{
+    return phase < TIMELINE_PHASES ? marks[phase] : 0;
+}
+
+/*
+ * timeline_dump()
+ *
+ * Writes the timeline as one line to "buf":
+ *   TIMELINE version=dev main=1021 stdio_init=1187 ...
+ * Times are in us since boot, phases not reached are left out.
+ * See linux/timeline_stats.py. Returns the length of the text.
+ */
+size_t timeline_dump(char *buf, size_t size)
+{
+    size_t len;
+    int n;
+
+    if(!size)
+        return 0;
+    n = snprintf(buf, size, "TIMELINE version=%s", FIRMWARE_VERSION);
+    len = (size_t)n < size ? (size_t)n : size - 1;
+    for(int i = 0; i < TIMELINE_PHASES; i++){
+        if(!marks[i])
+            continue;
+        n = snprintf(buf + len, size - len, " %s=%lu", phase_names[i], (unsigned long)marks[i]);
+        if((size_t)n >= size - len){
+            buf[len] = '\0';    // left out, does not fit
+            break;
+        }
+        len += n;
+    }
+    if(len + 1 < size){
+        buf[len++] = '\n';
+        buf[len] = '\0';
+    }
+    return len;
+}
+
+/*
+ * timeline_print()
+ *
+ * Prints the same as timeline_dump() to stdout.
+ */
+void timeline_print()
+{
+    char line[256];
+
+    timeline_dump(line, sizeof(line));
+    printf("%s", line);
+}
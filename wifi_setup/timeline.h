@@ -0,0 +1,50 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Boot timeline
+ *
+ * The time since boot (us) at which each startup phase was reached is
+ * kept in a table in RAM, only the first time a phase is reached counts.
+ * The table is dumped as a single line, see timeline_dump().
+ */
+
+// Reported with every dump, e.g. add_compile_definitions(FIRMWARE_VERSION="1.2")
+#ifndef FIRMWARE_VERSION
+#define FIRMWARE_VERSION "dev"
+#endif
+
+typedef enum _timeline_phase {
+    TIMELINE_MAIN,          // main() entered
+    TIMELINE_STDIO_INIT,    // stdio_init_all() done
+    TIMELINE_CYW43_INIT,    // cyw43_arch_init() done
+    TIMELINE_FLASH_READ,    // configuration read from flash
+    TIMELINE_FORCE_SETUP,   // decided whether to run the setup
+    TIMELINE_AP_START,      // access point for the setup is up
+    TIMELINE_ASSOCIATED,    // station associated
+    TIMELINE_DHCP_BOUND,    // station has its address (DHCP or static)
+    TIMELINE_TCP_LISTEN,    // first TCP server listening
+    TIMELINE_PHASES
+} timeline_phase;
+
+void timeline_mark(timeline_phase phase);
+uint32_t timeline_get(timeline_phase phase);
+size_t timeline_dump(char *buf, size_t size);
+void timeline_print();
+
+#endif // TIMELINE_H
@@ -0,0 +1,147 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+#include "trace.h"
+
+/*
+ * The sites are added to the list when they are first recorded.
+ * Callbacks run in interrupt context (pico_cyw43_arch_lwip_threadsafe_background),
+ * so the counters are updated with interrupts disabled for a few
+ * instructions.
+ *
+ * A duration above the budget of the site is counted and, unless
+ * recorded in an interrupt handler, logged at once. Define
+ * TRACE_BUDGET_ASSERT to stop with an assertion instead.
+ */
+static trace_site *sites;
+
+void trace_record(trace_site *site, uint32_t us)
+{
+    uint32_t budget = site->budget_us ? site->budget_us : TRACE_BUDGET_US;
+    int bucket = us ? 32 - __builtin_clz(us) : 0;
+    if(bucket >= TRACE_BUCKETS)
+        bucket = TRACE_BUCKETS - 1;
+
+    uint32_t interrupts = save_and_disable_interrupts();
+    if(!site->listed){
+        site->next = sites;
+        sites = site;
+        site->listed = true;
+    }
+    site->count++;
+    site->total_us += us;
+    if(us > site->max_us)
+        site->max_us = us;
+    site->hist[bucket]++;
+    if(us > budget)
+        site->over_budget++;
+    restore_interrupts(interrupts);
+
+    if(us > budget){
+#ifdef TRACE_BUDGET_ASSERT
+        assert(us <= budget);
+#endif
+        if(!__get_current_exception())
+            printf("trace: %s took %lu us, budget %lu us\n",
+                   site->name, (unsigned long)us, (unsigned long)budget);
+    }
+}
+
+// Formats one site, returns the number of characters (as snprintf)
+static int format_site(const trace_site *s, char *buf, size_t size)
+{
+    int n = snprintf(buf, size, "%-14s n %lu avg %lu max %lu over %lu |",
+                     s->name, (unsigned long)s->count,
+                     (unsigned long)(s->count ? s->total_us / s->count : 0),
+                     (unsigned long)s->max_us, (unsigned long)s->over_budget);
+
+    for(int i = 0; i < TRACE_BUCKETS; i++){
+        if(!s->hist[i] || (size_t)n >= size)
+            continue;
+        if(i < TRACE_BUCKETS - 1)
+            n += snprintf(buf + n, size - n, " <%lu:%lu",
+                          (unsigned long)(1u << i), (unsigned long)s->hist[i]);
+        else
+            n += snprintf(buf + n, size - n, " >=%lu:%lu",
+                          (unsigned long)(1u << (i - 1)), (unsigned long)s->hist[i]);
+    }
+    if((size_t)n < size)
+        n += snprintf(buf + n, size - n, "\n");
+    return n;
+}
+
+/*
+ * trace_dump()
+ *
+ * Writes a line per site to "buf": number of calls, average, longest
+ * duration and how often the budget was exceeded (all in us), followed by
+ * the histogram ("<4:7" means 7 calls took 2 or 3 us).
+ * Sites that do not fit are left out. Returns the length of the text.
+ */
+size_t trace_dump(char *buf, size_t size)
+{
+    size_t len = 0;
+
+    if(!size)
+        return 0;
+    buf[0] = '\0';
+    for(const trace_site *s = sites; s; s = s->next){
+        int n = format_site(s, buf + len, size - len);
+        if((size_t)n >= size - len){
+            buf[len] = '\0';
+            break;
+        }
+        len += n;
+    }
+    return len;
+}
+
+/*
+ * trace_print()
+ *
+ * Prints the same as trace_dump() to stdout.
+ */
+void trace_print()
+{
+    char line[256];
+
+    printf("Trace (us, budget %d us):\n", TRACE_BUDGET_US);
+    for(const trace_site *s = sites; s; s = s->next){
+        format_site(s, line, sizeof(line));
+        printf("\t%s", line);
+    }
+}
+
+/*
+ * trace_reset()
+ *
+ * Clears the counters and histograms of all sites.
+ */
+void trace_reset()
+{
+    uint32_t interrupts = save_and_disable_interrupts();
+    for(trace_site *s = sites; s; s = s->next){
+        s->count = 0;
+        s->total_us = 0;
+        s->max_us = 0;
+        s->over_budget = 0;
+        memset(s->hist, 0, sizeof(s->hist));
+    }
+    restore_interrupts(interrupts);
+}
@@ -0,0 +1,75 @@
+/**
+ * This file is part of "Wi-Fi Configure.
+ *
+ * This software eliminates the need to know the network name, password and,
+ * if required, IP address, network mask and default gateway at compile time.
+ * These can be set directly on the Pico-W and also changed afterwards.
+ *
+ * Copyright (c) 2024 Gerhard Schiller gerhard.schiller@pm.me
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pico/stdlib.h"
+
+/*
+ * Tracing of critical sections and callbacks
+ *
+ *  TRACE_SITE(flash_trace, "flash erase");
+ *  ...
+ *  uint32_t t = TRACE_BEGIN();
+ *  ... code that blocks ...
+ *  TRACE_END(flash_trace, t);
+ *
+ * Every call site gets a histogram of the durations (timer based, in us).
+ * Durations above the budget are counted and logged, see trace.c.
+ * Define TRACE_ENABLED as 0 to remove the tracing completely.
+ */
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+// Default budget of a call site
+#ifndef TRACE_BUDGET_US
+#define TRACE_BUDGET_US 2000
+#endif
+
+// Buckets of the histograms: < 1us, < 2us, < 4us, ... , >= 16ms
+#define TRACE_BUCKETS 16
+
+typedef struct _trace_site {
+    const char *name;
+    uint32_t    budget_us;      // 0: TRACE_BUDGET_US
+    struct _trace_site *next;   // list of the sites seen so far
+    bool        listed;
+    uint32_t    count;
+    uint64_t    total_us;
+    uint32_t    max_us;
+    uint32_t    over_budget;
+    uint32_t    hist[TRACE_BUCKETS];
+} trace_site;
+
+#define TRACE_SITE(var, name)               static trace_site var = { name, 0 }
+#define TRACE_SITE_BUDGET(var, name, us)    static trace_site var = { name, us }
+
+#if TRACE_ENABLED
+#define TRACE_BEGIN()               time_us_32()
+#define TRACE_END(site, start)      trace_record(&(site), time_us_32() - (start))
+#else
+#define TRACE_BEGIN()               0
+#define TRACE_END(site, start)      ((void)(site), (void)(start))
+#endif
+
+void trace_record(trace_site *site, uint32_t us);
+size_t trace_dump(char *buf, size_t size);
+void trace_print();
+void trace_reset();
+
+#endif // TRACE_H